@@ -0,0 +1,95 @@
+/*
+ *  This is free software: you can redistribute it and/or modify it
+ *  under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  any later version.
+ *  The software is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *  You should have received a copy of the GNU General Public License
+ *  along with the software. If not, see <http://www.gnu.org/licenses/>.
+ *
+ *  Copyright 2020, Willem L, Kuylen E, Broeckhove J
+ */
+
+/**
+ * @file
+ * Implementation of the ContactPolicy class.
+ */
+
+#include "ContactPolicy.h"
+
+#include "calendar/Calendar.h"
+#include "pop/Population.h"
+
+#include <algorithm>
+
+namespace stride {
+
+using namespace std;
+using namespace stride::ContactType;
+
+ContactPolicy::ContactPolicy()
+    : m_profiles(), m_factors(1.0), m_school_factors(), m_cluster_members(), m_cnt_intensity_householdCluster(0),
+      m_present(true), m_school_closed(), m_isolated_from_household(false)
+{
+        m_school_factors.fill(1.0);
+        m_school_closed.fill(false);
+}
+
+void ContactPolicy::Initialize(const AgeContactProfiles& profiles, const Population& population)
+{
+        m_profiles = profiles;
+
+        // get the number of non-household members in the HouseholdCluster,
+        // negative values mean: not part of a HouseholdCluster
+        unsigned int max_id = 0U;
+        for (const auto& p : population) {
+                max_id = max(max_id, p.GetId());
+        }
+        m_cluster_members.assign(population.empty() ? 0U : max_id + 1U, 0U);
+        for (const auto& p : population) {
+                const double householdCluster_non_household_members =
+                    static_cast<double>(population.GetPoolSize(Id::HouseholdCluster, &p)) -
+                    population.GetPoolSize(Id::Household, &p);
+                if (householdCluster_non_household_members > 0) {
+                        m_cluster_members[p.GetId()] = static_cast<unsigned int>(householdCluster_non_household_members);
+                }
+        }
+}
+
+void ContactPolicy::Update(const Calendar& calendar, double cnt_intensity_householdCluster,
+                           bool isIsolatedFromHousehold)
+{
+        // account for physical distancing at work, in the community and in the collectivity
+        m_factors[Id::Workplace]          = 1 - calendar.GetWorkplaceDistancingFactor();
+        m_factors[Id::PrimaryCommunity]   = 1 - calendar.GetCommunityDistancingFactor();
+        m_factors[Id::SecondaryCommunity] = 1 - calendar.GetCommunityDistancingFactor();
+        m_factors[Id::Collectivity]       = 1 - calendar.GetCollectivityDistancingFactor();
+
+        // account for physical distancing at school, given the minimum age of the members
+        for (unsigned int age = 0; age < m_school_factors.size(); age++) {
+                m_school_factors[age] = 1 - calendar.GetSchoolDistancingFactor(age);
+        }
+
+        // account for contact intensity in household clusters
+        m_factors[Id::HouseholdCluster]  = cnt_intensity_householdCluster;
+        m_cnt_intensity_householdCluster = cnt_intensity_householdCluster;
+
+        // presence: at home (or in their collectivity), at work or in the community by type of day,
+        // in household clusters if allowed, and at school unless closed for the age
+        const bool isRegularWeekday       = calendar.IsRegularWeekday();
+        m_present[Id::Household]          = true;
+        m_present[Id::Collectivity]       = true;
+        m_present[Id::HouseholdCluster]   = calendar.IsHouseholdClusteringAllowed();
+        m_present[Id::Workplace]          = isRegularWeekday;
+        m_present[Id::PrimaryCommunity]   = !isRegularWeekday;
+        m_present[Id::SecondaryCommunity] = isRegularWeekday;
+        for (unsigned int age = 0; age < m_school_closed.size(); age++) {
+                m_school_closed[age] = calendar.IsSchoolClosed(age);
+        }
+        m_isolated_from_household = isIsolatedFromHousehold;
+}
+
+} // namespace stride
@@ -0,0 +1,188 @@
+/*
+ *  This is free software: you can redistribute it and/or modify it
+ *  under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  any later version.
+ *  The software is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *  You should have received a copy of the GNU General Public License
+ *  along with the software. If not, see <http://www.gnu.org/licenses/>.
+ *
+ *  Copyright 2020, Willem L, Kuylen E, Broeckhove J
+ */
+
+/**
+ * @file
+ * Header for the ContactPolicy class.
+ */
+
+#pragma once
+
+#include "contact/AgeContactProfiles.h"
+#include "contact/ContactPoolView.h"
+#include "contact/ContactType.h"
+#include "contact/IdSubscriptArray.h"
+#include "pop/Age.h"
+#include "pop/Person.h"
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <vector>
+
+namespace stride {
+
+class Calendar;
+class Population;
+
+/**
+ * Snapshot of the contact rates that apply on the current simulation day.
+ * The distancing factors of the calendar and the household cluster intensity
+ * are resolved once per day (in Update) so that the Infector only needs
+ * table lookups to compute the contact probability of a pair of members.
+ * The same holds for the presence of persons in the contact pools: it follows from
+ * the type of day and the school closures, except for the absences of a symptomatic
+ * person (see Person::DrawAbsences) and for isolation.
+ */
+class ContactPolicy
+{
+public:
+        /// Default constructor, no contacts until initialized.
+        ContactPolicy();
+
+        /// Store the age-related contact profiles and count, for each person, the members
+        /// of its household cluster that are not part of its household (static over the run).
+        void Initialize(const AgeContactProfiles& profiles, const Population& population);
+
+        /// Resolve the distancing factors, household cluster intensity and presence for the current day.
+        void Update(const Calendar& calendar, double cnt_intensity_householdCluster, bool isIsolatedFromHousehold);
+
+        /// Is the person present today in a pool of the given type? For K12 schools, closure
+        /// depends on the minimum age of the pool members, for colleges on the age of the person.
+        bool IsPresent(const Person& p, ContactType::Id type, unsigned int min_age) const
+        {
+                if (p.InIsolation()) {
+                        return type == ContactType::Id::Household && !m_isolated_from_household;
+                }
+                if (p.IsAbsent(type)) {
+                        return false;
+                }
+                if (type == ContactType::Id::K12School) {
+                        return !IsSchoolClosed(min_age);
+                }
+                if (type == ContactType::Id::College) {
+                        return !IsSchoolClosed(static_cast<unsigned int>(p.GetAge()));
+                }
+                return m_present[type];
+        }
+
+        /// Contact adjustment factor for compliant members of a pool of the given type.
+        /// For schools, the factor depends on the minimum age of the pool members.
+        double GetAdjustmentFactor(ContactType::Id type, unsigned int min_age) const
+        {
+                if (type == ContactType::Id::K12School || type == ContactType::Id::College) {
+                        return (min_age < m_school_factors.size()) ? m_school_factors[min_age] : 0.0;
+                }
+                return m_factors[type];
+        }
+
+        /// Contact intensity in household clusters for the current day.
+        double GetHouseholdClusterIntensity() const { return m_cnt_intensity_householdCluster; }
+
+        /// Reference number of contacts of the person in a pool of the given type, scaled with the
+        /// adjustment factor and reduced with the contacts already made within its household cluster.
+        double GetReferenceContacts(ContactType::Id type, const Person* p, double adjustment) const
+        {
+                return GetReferenceContacts(type, EffectiveAge(static_cast<unsigned int>(p->GetAge())), p->GetId(),
+                                            adjustment);
+        }
+
+        /// Reference number of contacts for the given effective age and person id (see above).
+        double GetReferenceContacts(ContactType::Id type, unsigned int effective_age, unsigned int id,
+                                    double adjustment) const
+        {
+                double reference_num_contacts = m_profiles[type][effective_age] * adjustment;
+
+                if (m_cnt_intensity_householdCluster > 0 &&
+                    (type == ContactType::Id::PrimaryCommunity || type == ContactType::Id::SecondaryCommunity)) {
+                        reference_num_contacts -= m_cluster_members[id] * m_cnt_intensity_householdCluster;
+                        reference_num_contacts = reference_num_contacts < 0 ? 0 : reference_num_contacts;
+                }
+                return reference_num_contacts;
+        }
+
+        /// Contact probability between members i1 and i2 of a pool of the given type and size. The adjustment
+        /// factor accounts for physical distancing in the pool and is ignored when one of the persons
+        /// is a non-complier to social distancing measures in this particular pool type.
+        double GetContactProbability(const ContactPoolView& view, std::size_t i1, std::size_t i2, std::size_t pool_size,
+                                     ContactType::Id type, double adjustment) const
+        {
+                // assume fully connected households
+                if (type == ContactType::Id::Household) {
+                        return 0.999;
+                }
+
+                // exclude contacts with household members within household cluster
+                if (type == ContactType::Id::HouseholdCluster) {
+                        return (view.GetHouseholdId(i1) == view.GetHouseholdId(i2)) ? 0.0
+                                                                                    : m_cnt_intensity_householdCluster;
+                }
+
+                // check if one of the persons is a non-complier to social distancing measures in this particular pooltype
+                if (view.IsNonComplier(i1) || view.IsNonComplier(i2)) {
+                        adjustment = 1;
+                }
+
+                // get the reference number of contacts, given age, distancing and household cluster
+                const double reference_num_contacts_p1 = GetReferenceContacts(type, view.GetAge(i1), view.GetId(i1), adjustment);
+                const double reference_num_contacts_p2 = GetReferenceContacts(type, view.GetAge(i2), view.GetId(i2), adjustment);
+                const double potential_num_contacts{static_cast<double>(pool_size - 1)};
+
+                // use the minimum of both age-specific probabilities, limited to 0.999
+                const double contact_probability =
+                    std::min(reference_num_contacts_p1, reference_num_contacts_p2) / potential_num_contacts;
+                return (contact_probability >= 1) ? 0.999 : contact_probability;
+        }
+
+        /// Upper bound of GetContactProbability for member i1 and any other member of the pool.
+        /// Distancing (with distancing factors in [0,1]) only lowers the reference number of contacts,
+        /// so it suffices to look at the person's own reference without distancing.
+        double GetContactProbabilityBound(const ContactPoolView& view, std::size_t i1, std::size_t pool_size,
+                                          ContactType::Id type) const
+        {
+                // assume fully connected households
+                if (type == ContactType::Id::Household) {
+                        return 0.999;
+                }
+
+                // contact intensity in household clusters
+                if (type == ContactType::Id::HouseholdCluster) {
+                        return m_cnt_intensity_householdCluster;
+                }
+
+                const double reference_num_contacts_p1 = GetReferenceContacts(type, view.GetAge(i1), view.GetId(i1), 1.0);
+                const double potential_num_contacts{static_cast<double>(pool_size - 1)};
+                const double individual_contact_probability_p1 = reference_num_contacts_p1 / potential_num_contacts;
+
+                // probabilities are limited to 0.999 only when they exceed 1
+                return (individual_contact_probability_p1 >= 1) ? 0.999 : individual_contact_probability_p1;
+        }
+
+private:
+        /// Are schools closed today for the given age?
+        bool IsSchoolClosed(unsigned int age) const { return age < m_school_closed.size() && m_school_closed[age]; }
+
+private:
+        AgeContactProfiles                       m_profiles;        ///< Age-related contact profiles per pool type.
+        ContactType::IdSubscriptArray<double>    m_factors;         ///< Adjustment factor per pool type for today.
+        std::array<double, MaximumAge() + 1>     m_school_factors;  ///< School adjustment factor per minimum age.
+        std::vector<unsigned int>                m_cluster_members; ///< Non-household cluster members per person id.
+        double                                   m_cnt_intensity_householdCluster; ///< Intensity for today.
+        ContactType::IdSubscriptArray<bool>      m_present;         ///< Presence per pool type for today (schools aside).
+        std::array<bool, 256>                    m_school_closed;   ///< Are schools closed today, per age?
+        bool                                     m_isolated_from_household; ///< Are isolated persons absent from home?
+};
+
+} // namespace stride
@@ -30,12 +30,14 @@ namespace stride {
 using namespace std;
 
 ContactPool::ContactPool(unsigned int poolId, ContactType::Id type)
-    : m_index_immune(0), m_pool_id(poolId), m_pool_type(type), m_members(), m_min_age(110)
+    : m_num_infectious(0), m_index_susceptible(0), m_index_immune(0), m_is_active(false), m_pool_id(poolId), m_pool_type(type), m_members(), m_min_age(110)
 {
 }
 
 void ContactPool::AddMember(Person* p)
 {
+        // new members are susceptible until health is seeded and the pool is sorted
+        p->SetPoolSlot(m_pool_type, static_cast<unsigned int>(m_members.size()));
         m_members.emplace_back(p);
         m_index_immune++;
 
@@ -56,39 +58,79 @@ unsigned int ContactPool::GetInfectedCount() const
         return infected;
 }
 
-std::tuple<bool, unsigned int> ContactPool::SortMembers()
+namespace {
+
+/// Partition of the ContactPool that corresponds with the health status.
+inline unsigned int GetPartition(const Health& h)
 {
-        bool         infectious_cases = false;
-        unsigned int num_cases        = 0;
-
-        for (size_t i_member = 0; i_member < m_index_immune; i_member++) {
-                // if immune, move to back
-                if (m_members[i_member]->GetHealth().IsImmune()) {
-                        bool         swapped   = false;
-                        unsigned int new_place = m_index_immune - 1;
-                        m_index_immune--;
-                        while (!swapped && new_place > i_member) {
-                                if (m_members[new_place]->GetHealth().IsImmune()) {
-                                        m_index_immune--;
-                                        new_place--;
-                                } else {
-                                        swap(m_members[i_member], m_members[new_place]);
-                                        swapped = true;
-                                }
-                        }
+        return h.IsInfectious() ? 0U : (h.IsInfected() ? 1U : (h.IsSusceptible() ? 2U : 3U));
+}
+
+} // namespace
+
+void ContactPool::SortMembers()
+{
+        // stable partition: infectious, other infected, susceptible, recovered/immune
+        unsigned int* const bounds[] = {&m_num_infectious, &m_index_susceptible, &m_index_immune};
+        vector<Person*>     members;
+        members.reserve(m_members.size());
+        for (unsigned int part = 0U; part < 4U; part++) {
+                if (part > 0U) {
+                        *bounds[part - 1] = static_cast<unsigned int>(members.size());
                 }
-                // else, if not susceptible, move to front
-                else if (!m_members[i_member]->GetHealth().IsSusceptible()) {
-                        if (!infectious_cases && m_members[i_member]->GetHealth().IsInfectious()) {
-                                infectious_cases = true;
+                for (const auto p : m_members) {
+                        if (GetPartition(p->GetHealth()) == part) {
+                                p->SetPoolSlot(m_pool_type, static_cast<unsigned int>(members.size()));
+                                members.emplace_back(p);
                         }
-                        if (i_member > num_cases) {
-                                swap(m_members[i_member], m_members[num_cases]);
-                        }
-                        num_cases++;
                 }
         }
-        return std::make_tuple(infectious_cases, num_cases);
+        m_members.swap(members);
+}
+
+void ContactPool::ResetMembers()
+{
+        sort(m_members.begin(), m_members.end(), [](const Person* p1, const Person* p2) { return p1->GetId() < p2->GetId(); });
+        for (unsigned int i = 0U; i < m_members.size(); i++) {
+                m_members[i]->SetPoolSlot(m_pool_type, i);
+        }
+        m_num_infectious    = 0U;
+        m_index_susceptible = 0U;
+        m_index_immune      = static_cast<unsigned int>(m_members.size());
+        m_is_active         = false;
+}
+
+void ContactPool::UpdateMember(Person* p)
+{
+        unsigned int* const bounds[] = {&m_num_infectious, &m_index_susceptible, &m_index_immune};
+        auto                slot     = p->GetPoolSlot(m_pool_type);
+        const auto          target   = GetPartition(p->GetHealth());
+        auto                current  = 0U;
+        while (current < 3U && slot >= *bounds[current]) {
+                current++;
+        }
+
+        // move to the back: swap with the last member of the current partition and shrink it
+        while (current < target) {
+                auto& end = *bounds[current];
+                SwapMembers(slot, end - 1);
+                slot = --end;
+                current++;
+        }
+        // move to the front: swap with the first member of the current partition and grow the previous one
+        while (current > target) {
+                auto& begin = *bounds[current - 1];
+                SwapMembers(slot, begin);
+                slot = begin++;
+                current--;
+        }
+}
+
+void ContactPool::SwapMembers(unsigned int i, unsigned int j)
+{
+        swap(m_members[i], m_members[j]);
+        m_members[i]->SetPoolSlot(m_pool_type, i);
+        m_members[j]->SetPoolSlot(m_pool_type, j);
 }
 
 } // namespace stride
@@ -22,7 +22,7 @@
 
 #include "contact/ContactType.h"
 
-#include <tuple>
+#include <cstddef>
 #include <vector>
 
 #include "EventLogMode.h"
@@ -48,12 +48,31 @@ public:
         /// Add the given Person.
         void AddMember(Person* p);
 
+        /// Reserve room for the given number of members.
+        void ReserveMembers(std::size_t n) { m_members.reserve(n); }
+
+        /// Partition the members w.r.t. health status: infectious, other infected, susceptible, recovered/immune.
+        void SortMembers();
+
+        /// Put the members back in order of id (as PopBuilder adds them), all in the susceptible
+        /// partition, and out of the worklist (see Population::Reset).
+        void ResetMembers();
+
+        /// Move the given member to the partition that matches its (changed) health status.
+        void UpdateMember(Person* p);
+
         /// Get the pool id
         unsigned int GetId() const { return m_pool_id; }
 
         /// Get Infected count
         unsigned int GetInfectedCount() const;
 
+        /// Get the number of infectious members (kept up to date with the partitions).
+        unsigned int GetInfectiousCount() const { return m_num_infectious; }
+
+        /// Get the number of susceptible members (kept up to date with the partitions).
+        unsigned int GetSusceptibleCount() const { return m_index_immune - m_index_susceptible; }
+
         /// Get the entire pool of members.
         const std::vector<Person*>& GetPool() const { return m_members; }
 
@@ -83,15 +102,24 @@ public:
         Person* const& operator[](size_t index) const { return m_members[index]; }
 
 private:
-        /// Sort w.r.t. health status: order: exposed/infected/recovered, susceptible, immune.
-        std::tuple<bool, unsigned int> SortMembers();
+        /// Swap the members at the given indices.
+        void SwapMembers(unsigned int i, unsigned int j);
 
         /// Calculates contacts and transmissions; accesses private methods and data.
-        template <EventLogMode::Id LL, bool TIC, bool TO>
+        template <EventLogMode::Id LL, bool TIC, bool GS, bool TO>
         friend class Infector;
 
+        /// Keeps the worklists with active pools.
+        friend class ContactPoolSys;
+
+        /// Saves and restores the member order and partitions.
+        friend class SimCheckpoint;
+
 private:
-        unsigned int         m_index_immune; ///< Index of the first immune member in the ContactPool.
+        unsigned int         m_num_infectious; ///< Number of infectious members, at the front of the ContactPool.
+        unsigned int         m_index_susceptible; ///< Index of the first susceptible member in the ContactPool.
+        unsigned int         m_index_immune; ///< Index of the first recovered/immune member in the ContactPool.
+        bool                 m_is_active;    ///< Is the pool in the worklist of its ContactPoolSys?
         unsigned int         m_pool_id;      ///< The ID of the ContactPool (for logging purposes).
         ContactType::Id      m_pool_type;    ///< The type of the ContactPool (for logging and testing purposes).
         std::vector<Person*> m_members;      ///< Pointers to contactpool members (raw pointers intentional).
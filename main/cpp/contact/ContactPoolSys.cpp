@@ -20,12 +20,14 @@
 
 #include "ContactPoolSys.h"
 
+#include <algorithm>
+
 using namespace std;
 using namespace stride::ContactType;
 
 namespace stride {
 
-ContactPoolSys::ContactPoolSys() : m_currentContactPoolId(), m_sys()
+ContactPoolSys::ContactPoolSys() : m_currentContactPoolId(), m_sys(), m_active()
 {
         for (Id typ : IdList) {
                 m_sys[typ].emplace_back(ContactPool(0U, typ));
@@ -38,4 +40,19 @@ ContactPool* ContactPoolSys::CreateContactPool(ContactType::Id typeId)
         return m_sys[typeId].emplace_back(m_currentContactPoolId[typeId]++, typeId);
 }
 
+void ContactPoolSys::UpdateActivePools()
+{
+        for (Id typ : IdList) {
+                auto& active = m_active[typ];
+                auto& pools  = m_sys[typ];
+                const auto last = remove_if(active.begin(), active.end(), [&pools](unsigned int poolId) {
+                        auto& pool = pools[poolId];
+                        pool.m_is_active = pool.GetInfectiousCount() > 0;
+                        return !pool.m_is_active;
+                });
+                active.erase(last, active.end());
+                sort(active.begin(), active.end());
+        }
+}
+
 } // namespace stride
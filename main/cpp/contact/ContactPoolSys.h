@@ -25,6 +25,8 @@
 #include "contact/ContactPool.h"
 #include "util/SegmentedVector.h"
 
+#include <vector>
+
 namespace stride {
 
 /**
@@ -65,6 +67,23 @@ public:
                 return m_sys[T];
         }
 
+        /// Ids of the pools of type 'id' that are in the worklist: all pools with infectious
+        /// members (after UpdateActivePools, sorted by id), possibly some without.
+        const std::vector<unsigned int>& CRefActivePools(ContactType::Id id) const { return m_active[id]; }
+
+        /// Add the pool to the worklist of its type if it has infectious members.
+        void ActivatePool(ContactType::Id id, unsigned int poolId)
+        {
+                auto& pool = m_sys[id][poolId];
+                if (!pool.m_is_active && pool.GetInfectiousCount() > 0) {
+                        pool.m_is_active = true;
+                        m_active[id].emplace_back(poolId);
+                }
+        }
+
+        /// Remove the pools without infectious members from the worklists and sort them by id.
+        void UpdateActivePools();
+
 private:
         /// /// Access through non-const reference to ContactPools of type 'id'.
         /// \param id   ContactType::Id of pools container you want to access.
@@ -72,7 +91,10 @@ private:
         util::SegmentedVector<ContactPool>& RefPools(ContactType::Id id) { return m_sys[id]; }
 
         friend class PopBuilder;
+        friend class PopSnapshot;
+        friend class Population;
         friend class Sim;
+        friend class SimCheckpoint;
 
 private:
         /// The contact pool counters (one per type id) for assigning pool UIDs. Counters
@@ -90,6 +112,9 @@ private:
         /// We use the SegmentedVector not to run in re-allocations and to be able to use
         /// pointers into the SegmentedVector.
         ContactType::IdSubscriptArray<util::SegmentedVector<ContactPool>> m_sys;
+
+        /// Worklist for each type with the ids of the pools that have infectious members.
+        ContactType::IdSubscriptArray<std::vector<unsigned int>> m_active;
 };
 
 } // namespace stride
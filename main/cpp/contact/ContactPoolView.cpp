@@ -0,0 +1,67 @@
+/*
+ *  This is free software: you can redistribute it and/or modify it
+ *  under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  any later version.
+ *  The software is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *  You should have received a copy of the GNU General Public License
+ *  along with the software. If not, see <http://www.gnu.org/licenses/>.
+ *
+ *  Copyright 2020, Willem L, Kuylen E, Broeckhove J
+ */
+
+/**
+ * @file
+ * Implementation of the ContactPoolView class.
+ */
+
+#include "ContactPoolView.h"
+
+#include "ContactPolicy.h"
+#include "ContactPool.h"
+#include "pop/Age.h"
+#include "pop/Person.h"
+
+namespace stride {
+
+using namespace std;
+
+void ContactPoolView::Load(const ContactPool& pool, size_t end, const ContactPolicy& policy)
+{
+        const auto pType  = pool.GetType();
+        const auto minAge = pool.GetMinAge();
+        const auto words = (end + 63) / 64;
+
+        // storage is reused from pool to pool, only grows
+        m_ids.resize(end);
+        m_households.resize(pType == ContactType::Id::HouseholdCluster ? end : 0U);
+        m_ages.resize(end);
+        m_status.resize(end);
+        m_susceptibility.resize(end);
+        m_present.assign(words, 0U);
+        m_non_compliers.assign(words, 0U);
+        m_recorded.assign(words, 0U);
+
+        for (size_t i = 0; i < end; i++) {
+                const Person* p    = pool[i];
+                const auto&   h    = p->GetHealth();
+                m_ids[i]            = p->GetId();
+                m_ages[i]           = static_cast<uint8_t>(EffectiveAge(static_cast<unsigned int>(p->GetAge())));
+                m_status[i]         = static_cast<uint8_t>(h.GetStatus());
+                m_susceptibility[i] = h.GetRelativeSusceptibility();
+                if (pType == ContactType::Id::HouseholdCluster) {
+                        m_households[i] = p->GetPoolId(ContactType::Id::Household);
+                }
+                const bool present = policy.IsPresent(*p, pType, minAge);
+                m_present[i / 64] |= static_cast<uint64_t>(present) << (i % 64);
+                m_non_compliers[i / 64] |= static_cast<uint64_t>(p->IsNonComplier(pType)) << (i % 64);
+                m_recorded[i / 64] |= static_cast<uint64_t>(present &&
+                                                            (p->IsSurveyParticipant() || p->IsTracingIndexCase()))
+                                      << (i % 64);
+        }
+}
+
+} // namespace stride
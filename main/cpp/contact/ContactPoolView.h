@@ -0,0 +1,124 @@
+/*
+ *  This is free software: you can redistribute it and/or modify it
+ *  under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  any later version.
+ *  The software is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *  You should have received a copy of the GNU General Public License
+ *  along with the software. If not, see <http://www.gnu.org/licenses/>.
+ *
+ *  Copyright 2020, Willem L, Kuylen E, Broeckhove J
+ */
+
+/**
+ * @file
+ * Header for the ContactPoolView class.
+ */
+
+#pragma once
+
+#include "disease/Health.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace stride {
+
+class ContactPolicy;
+class ContactPool;
+
+/**
+ * Column-wise (structure of arrays) copy of the member data of a ContactPool that
+ * the Infector needs for every pair: person id, effective age, health status,
+ * relative susceptibility and, for the type of the pool, presence, non-compliance and
+ * recorded bits. Loading a pool touches every member once; the contact loops then scan
+ * contiguous arrays instead of chasing Person pointers. Member i of the view is
+ * member i of the pool, so the view has to be reloaded after the pool is sorted.
+ */
+class ContactPoolView
+{
+public:
+        /// Empty view.
+        ContactPoolView()
+            : m_ids(), m_households(), m_ages(), m_status(), m_susceptibility(), m_present(), m_non_compliers(),
+              m_recorded()
+        {
+        }
+
+        /// Load the members [0, end) of the pool, as they are at this point in the time step,
+        /// with their presence today according to the policy.
+        void Load(const ContactPool& pool, std::size_t end, const ContactPolicy& policy);
+
+        /// Person id of the member.
+        unsigned int GetId(std::size_t i) const { return m_ids[i]; }
+
+        /// Effective age (see pop/Age.h) of the member.
+        unsigned int GetAge(std::size_t i) const { return m_ages[i]; }
+
+        /// Health status of the member.
+        HealthStatus GetStatus(std::size_t i) const { return static_cast<HealthStatus>(m_status[i]); }
+
+        /// Is the member infectious?
+        bool IsInfectious(std::size_t i) const
+        {
+                return GetStatus(i) == HealthStatus::Infectious || GetStatus(i) == HealthStatus::InfectiousAndSymptomatic;
+        }
+
+        /// Is the member susceptible?
+        bool IsSusceptible(std::size_t i) const { return GetStatus(i) == HealthStatus::Susceptible; }
+
+        /// Record a change of the health status of the member (infection within the pool).
+        void SetStatus(std::size_t i, HealthStatus status) { m_status[i] = static_cast<std::uint8_t>(status); }
+
+        /// Household id of the member (only loaded for HouseholdCluster pools).
+        unsigned int GetHouseholdId(std::size_t i) const { return m_households[i]; }
+
+        /// Relative susceptibility of the member.
+        double GetSusceptibility(std::size_t i) const { return m_susceptibility[i]; }
+
+        /// Is the member present in the pool today?
+        bool IsPresent(std::size_t i) const { return (m_present[i / 64] >> (i % 64)) & 1U; }
+
+        /// Is the member a non-complier to distancing measures in this type of pool?
+        bool IsNonComplier(std::size_t i) const { return (m_non_compliers[i / 64] >> (i % 64)) & 1U; }
+
+        /// Is the member present and are its contacts recorded (survey participant, tracing index case)?
+        bool IsRecorded(std::size_t i) const { return (m_recorded[i / 64] >> (i % 64)) & 1U; }
+
+        /// Index of the first present member in [i, end), or end if there is none.
+        std::size_t NextPresent(std::size_t i, std::size_t end) const { return Next(m_present, i, end); }
+
+        /// Index of the first recorded member (see IsRecorded) in [i, end), or end if there is none.
+        std::size_t NextRecorded(std::size_t i, std::size_t end) const { return Next(m_recorded, i, end); }
+
+private:
+        /// Index of the first set bit in [i, end), or end if there is none.
+        static std::size_t Next(const std::vector<std::uint64_t>& bits, std::size_t i, std::size_t end)
+        {
+                while (i < end) {
+                        const std::uint64_t word = bits[i / 64] >> (i % 64);
+                        if (word != 0U) {
+                                i += static_cast<std::size_t>(__builtin_ctzll(word));
+                                return (i < end) ? i : end;
+                        }
+                        i = (i / 64 + 1) * 64;
+                }
+                return end;
+        }
+
+private:
+        std::vector<unsigned int>  m_ids;            ///< Person id per member.
+        std::vector<unsigned int>  m_households;     ///< Household id per member (HouseholdCluster pools).
+        std::vector<std::uint8_t>  m_ages;           ///< Effective age per member.
+        std::vector<std::uint8_t>  m_status;         ///< HealthStatus per member.
+        std::vector<double>        m_susceptibility; ///< Relative susceptibility per member.
+        std::vector<std::uint64_t> m_present;        ///< Presence bits, 64 members per word.
+        std::vector<std::uint64_t> m_non_compliers;  ///< Non-compliance bits, 64 members per word.
+        std::vector<std::uint64_t> m_recorded;       ///< Recorded (and present) bits, 64 members per word.
+};
+
+} // namespace stride
@@ -23,7 +23,7 @@
 #include "contact/ContactType.h"
 
 #include <array>
-#include <bitset>
+#include <cstdint>
 #include <initializer_list>
 #include <iostream>
 #include <stdexcept>
@@ -127,59 +127,72 @@ public:
 };
 
 /**
- * Specialization of IdSubscriptArray for booleans.
+ * Specialization of IdSubscriptArray for booleans: one bit per type, packed in a byte
+ * (a std::bitset takes a full word), so that it fits in the hot data of a Person.
  */
 template <>
-class IdSubscriptArray<bool> : public std::bitset<NumOfTypes()>
+class IdSubscriptArray<bool>
 {
+public:
+        /// Reference to the bit of one type.
+        class reference
+        {
+        public:
+                ///
+                reference(std::uint8_t& bits, std::uint8_t mask) : m_bits(bits), m_mask(mask) {}
+
+                ///
+                reference& operator=(bool b)
+                {
+                        m_bits = static_cast<std::uint8_t>(b ? (m_bits | m_mask) : (m_bits & ~m_mask));
+                        return *this;
+                }
+
+                ///
+                reference& operator=(const reference& other) { return *this = static_cast<bool>(other); }
+
+                ///
+                operator bool() const { return (m_bits & m_mask) != 0U; }
+
+        private:
+                std::uint8_t& m_bits;
+                std::uint8_t  m_mask;
+        };
+
 public:
         /// What we will use most often and where we can have a default and
         /// initialize all array elements to the same value.
         /// e.g.    IdSubscriptArray<bool> m(true);
-        explicit IdSubscriptArray(bool t = bool())
-        {
-                if (t)
-                        this->set();
-                else
-                        this->reset();
-        }
+        explicit IdSubscriptArray(bool t = bool()) : m_bits(t ? ALL : 0U) {}
 
         /// When we want to use an initializer list the elements is the
         /// (possibly empty) initializer list are applied to the first
         /// elements in order; any remaining elements are default initialized.
         ///  e.g.   IdSubscriptArray<bool> mm {true, false, true};
-        IdSubscriptArray(std::initializer_list<bool> l)
+        IdSubscriptArray(std::initializer_list<bool> l) : m_bits(0U)
         {
                 auto it = l.begin();
                 for (auto typ : IdList) {
                         if (it != l.end()) {
                                 this->operator[](typ) = *it;
                                 ++it;
-                        } else {
-                                this->operator[](typ) = bool();
                         }
                 }
         }
 
         /// Subscripting with pool type id as argument.
-        typename std::bitset<NumOfTypes()>::reference operator[](ContactType::Id id)
-        {
-                return this->std::template bitset<NumOfTypes()>::operator[](ContactType::ToSizeT(id));
-        }
+        reference operator[](ContactType::Id id) { return reference(m_bits, Mask(id)); }
 
         /// Subscripting with pool type id as argument.
-        bool operator[](ContactType::Id id) const
-        {
-                return this->std::template bitset<NumOfTypes()>::operator[](ContactType::ToSizeT(id));
-        }
+        bool operator[](ContactType::Id id) const { return (m_bits & Mask(id)) != 0U; }
 
         /// Subscripting with pool type id as argument.
-        typename bitset<NumOfTypes()>::reference at(ContactType::Id id)
+        reference at(ContactType::Id id)
         {
                 if (ToSizeT(id) >= NumOfTypes()) {
                         throw std::out_of_range("IdSubscriptArray<bool>::at> Id out of range");
                 }
-                return this->std::template bitset<NumOfTypes()>::operator[](ContactType::ToSizeT(id));
+                return operator[](id);
         }
 
         /// Subscripting with pool type id as argument.
@@ -188,8 +201,20 @@ public:
                 if (ToSizeT(id) >= NumOfTypes()) {
                         throw std::out_of_range("IdSubscriptArray::at> Id out of range");
                 }
-                return this->std::template bitset<NumOfTypes()>::operator[](ContactType::ToSizeT(id));
+                return operator[](id);
         }
+
+private:
+        static_assert(NumOfTypes() <= 8U, "IdSubscriptArray<bool> packs the types in a byte");
+
+        /// All bits of the types.
+        static constexpr std::uint8_t ALL = static_cast<std::uint8_t>((1U << NumOfTypes()) - 1U);
+
+        /// Bit of the type.
+        static std::uint8_t Mask(ContactType::Id id) { return static_cast<std::uint8_t>(1U << ToSizeT(id)); }
+
+private:
+        std::uint8_t m_bits; ///< One bit per type.
 };
 
 } // namespace ContactType
@@ -0,0 +1,94 @@
+/*
+ *  This is free software: you can redistribute it and/or modify it
+ *  under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  any later version.
+ *  The software is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *  You should have received a copy of the GNU General Public License
+ *  along with the software. If not, see <http://www.gnu.org/licenses/>.
+ *
+ *  Copyright 2020, Willem L, Kuylen E, Broeckhove J
+ */
+
+/**
+ * @file
+ * Implementation of the InfectionBuffer class.
+ */
+
+#include "InfectionBuffer.h"
+
+#include "pop/Person.h"
+
+#include <algorithm>
+#include <omp.h>
+
+namespace stride {
+
+using namespace std;
+
+namespace {
+
+/// Merge the per-thread buffers and order by person, then by the given order. The sort is
+/// stable: proposals that are equal in both come from one pool, so one thread, and keep the
+/// order of proposal.
+template <typename T, typename Key, typename Less>
+void Merge(vector<vector<T>>& buffers, vector<T>& merged, Key key, Less less)
+{
+        merged.clear();
+        for (auto& buffer : buffers) {
+                merged.insert(merged.end(), buffer.begin(), buffer.end());
+                buffer.clear();
+        }
+        stable_sort(merged.begin(), merged.end(), [key, less](const T& a, const T& b) {
+                const auto idA = key(a)->GetId();
+                const auto idB = key(b)->GetId();
+                return idA < idB || (idA == idB && less(a, b));
+        });
+}
+
+} // namespace
+
+void InfectionBuffer::SetNumThreads(unsigned int numThreads)
+{
+        m_infections.resize(numThreads);
+        m_contacts.resize(numThreads);
+}
+
+void InfectionBuffer::ProposeInfection(Person* infectee, Person* infector, ContactType::Id type,
+                                       double relInfectiousness, double draw)
+{
+        m_infections[static_cast<size_t>(omp_get_thread_num())].emplace_back(
+            Infection{infectee, infector, type, relInfectiousness, draw});
+}
+
+void InfectionBuffer::ProposeContact(Person* indexCase, Person* contact, ContactType::Id type)
+{
+        if (indexCase->IsTracingIndexCase()) {
+                m_contacts[static_cast<size_t>(omp_get_thread_num())].emplace_back(Contact{indexCase, contact, type});
+        }
+}
+
+const vector<InfectionBuffer::Infection>& InfectionBuffer::CollectInfections()
+{
+        Merge(m_infections, m_commit_infections, [](const Infection& i) { return i.infectee; },
+              [](const Infection& a, const Infection& b) {
+                      return a.draw < b.draw || (a.draw == b.draw && a.type < b.type);
+              });
+        // keep the proposal with the lowest draw per infectee
+        const auto last = unique(m_commit_infections.begin(), m_commit_infections.end(),
+                                 [](const Infection& a, const Infection& b) { return a.infectee == b.infectee; });
+        m_commit_infections.erase(last, m_commit_infections.end());
+        return m_commit_infections;
+}
+
+const vector<InfectionBuffer::Contact>& InfectionBuffer::CollectContacts()
+{
+        Merge(m_contacts, m_commit_contacts, [](const Contact& c) { return c.index_case; },
+              [](const Contact& a, const Contact& b) { return a.type < b.type; });
+        return m_commit_contacts;
+}
+
+} // namespace stride
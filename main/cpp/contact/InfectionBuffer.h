@@ -0,0 +1,89 @@
+/*
+ *  This is free software: you can redistribute it and/or modify it
+ *  under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  any later version.
+ *  The software is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *  You should have received a copy of the GNU General Public License
+ *  along with the software. If not, see <http://www.gnu.org/licenses/>.
+ *
+ *  Copyright 2020, Willem L, Kuylen E, Broeckhove J
+ */
+
+/**
+ * @file
+ * Header for the InfectionBuffer class.
+ */
+
+#pragma once
+
+#include "contact/ContactType.h"
+
+#include <vector>
+
+namespace stride {
+
+class Person;
+
+/**
+ * Infections and contact registrations proposed by the Infector in the contact phase.
+ * A person is a member of pools of several types that may be processed concurrently, so the
+ * Infector does not change persons itself: each thread records its proposals in its own
+ * buffer and the proposals are committed after all pools have been processed.
+ * Each proposal carries a uniform draw of its own: per infectee, the proposal with the lowest
+ * draw wins, so the infector and the setting of a contested infection are drawn at random,
+ * whatever the order in which the pools were processed.
+ */
+class InfectionBuffer
+{
+public:
+        /// Proposed infection.
+        struct Infection
+        {
+                Person*         infectee;                ///< Susceptible person that gets infected.
+                Person*         infector;                ///< Infectious person.
+                ContactType::Id type;                    ///< Type of the pool with the transmission.
+                double          relative_infectiousness; ///< Draw for the infectiousness of the infectee.
+                double          draw;                    ///< Uniform draw, the lowest proposal wins.
+        };
+
+        /// Proposed registration of a contact (for contact tracing).
+        struct Contact
+        {
+                Person*         index_case; ///< Person with the contact register.
+                Person*         contact;    ///< Person to add to the register.
+                ContactType::Id type;       ///< Type of the pool with the contact.
+        };
+
+public:
+        /// One buffer (OpenMP thread).
+        InfectionBuffer() : m_infections(1), m_contacts(1), m_commit_infections(), m_commit_contacts() {}
+
+        /// Set up one buffer for each of the given number of (OpenMP) threads.
+        void SetNumThreads(unsigned int numThreads);
+
+        /// Propose an infection with the given uniform draw, in the buffer of the calling thread.
+        void ProposeInfection(Person* infectee, Person* infector, ContactType::Id type, double relInfectiousness,
+                              double draw);
+
+        /// Propose a contact registration, in the buffer of the calling thread.
+        /// Only tracing index cases keep a contact register.
+        void ProposeContact(Person* indexCase, Person* contact, ContactType::Id type);
+
+        /// The proposed infection with the lowest draw of each infectee, in order of infectee id. Clears the buffers.
+        const std::vector<Infection>& CollectInfections();
+
+        /// All proposed contact registrations, grouped per index case in order of proposal. Clears the buffers.
+        const std::vector<Contact>& CollectContacts();
+
+private:
+        std::vector<std::vector<Infection>> m_infections;        ///< Proposed infections per thread.
+        std::vector<std::vector<Contact>>   m_contacts;          ///< Proposed contact registrations per thread.
+        std::vector<Infection>              m_commit_infections; ///< Infections to commit.
+        std::vector<Contact>                m_commit_contacts;   ///< Contact registrations to commit.
+};
+
+} // namespace stride
@@ -21,9 +21,12 @@
 #include "Infector.h"
 
 #include "ContactPool.h"
-#include "calendar/Calendar.h"
+#include "ContactPoolView.h"
+#include "pop/EventRecord.h"
 #include "pop/Person.h"
 
+#include <algorithm>
+
 using namespace std;
 
 namespace {
@@ -34,13 +37,12 @@ template <EventLogMode::Id LL>
 class LOG_POLICY
 {
 public:
-        static void Contact(const std::shared_ptr<spdlog::logger>&, const Person*, const Person*, ContactType::Id,
-                            unsigned short int, const double, const double)
+        static void Contact(EventLog&, const Person*, const Person*, ContactType::Id, unsigned short int, const double,
+                            const double)
         {
         }
 
-        static void Trans(const std::shared_ptr<spdlog::logger>&, const Person*, const Person*, ContactType::Id,
-                          unsigned short int, unsigned int)
+        static void Trans(EventLog&, const Person*, const Person*, ContactType::Id, unsigned short int, unsigned int)
         {
         }
 };
@@ -50,22 +52,16 @@ template <>
 class LOG_POLICY<EventLogMode::Id::Incidence>
 {
 public:
-        static void Contact(const std::shared_ptr<spdlog::logger>&, const Person*, const Person*, ContactType::Id,
-                            unsigned short int, const double, const double)
+        static void Contact(EventLog&, const Person*, const Person*, ContactType::Id, unsigned short int, const double,
+                            const double)
         {
         }
 
         // p1: infector & p2:infectee
-        static void Trans(const std::shared_ptr<spdlog::logger>& logger, const Person* p1, const Person* p2,
-                          ContactType::Id type, unsigned short int sim_day, unsigned int id_index_case)
+        static void Trans(EventLog& log, const Person*, const Person* p2, ContactType::Id, unsigned short int sim_day,
+                          unsigned int)
         {
-                logger->info("[TRAN_M] {} {} {} {} {}",
-							 p2->GetAge(),
-							 sim_day,
-							 p2->GetHealth().GetStartInfectiousness(),
-							 p2->GetHealth().GetStartSymptomatic(),
-							 p2->GetHealth().GetEndSymptomatic()
-							 );
+                log.Log(EventRecord::TransmissionIncidence(p2, sim_day));
         }
 };
 
@@ -74,22 +70,17 @@ template <>
 class LOG_POLICY<EventLogMode::Id::Transmissions>
 {
 public:
-        static void Contact(const std::shared_ptr<spdlog::logger>&, const Person*, const Person*, ContactType::Id,
-                            unsigned short int, const double, const double)
+        static void Contact(EventLog&, const Person*, const Person*, ContactType::Id, unsigned short int, const double,
+                            const double)
         {
         }
 
         // p1: infector & p2:infectee
-        static void Trans(const std::shared_ptr<spdlog::logger>& logger, const Person* p1, const Person* p2,
-                          ContactType::Id type, unsigned short int sim_day, unsigned int id_index_case)
+        static void Trans(EventLog& log, const Person* p1, const Person* p2, ContactType::Id type,
+                          unsigned short int sim_day, unsigned int id_index_case)
         {
-                logger->info("[TRAN] {} {} {} {} {} {} {} {} {} {} {} {} {} {}", p2->GetId(), p1->GetId(), p2->GetAge(), p1->GetAge(),
-                             ToString(type), sim_day, id_index_case,
-							 p2->GetHealth().GetStartInfectiousness(),p2->GetHealth().GetEndInfectiousness(),
-							 p2->GetHealth().GetStartSymptomatic(),p2->GetHealth().GetEndSymptomatic(),
-							 p1->GetHealth().IsSymptomatic(),
-							 p2->GetHealth().GetRelativeInfectiousness(),
-							 p2->GetHealth().GetRelativeSusceptibility());
+                log.Log(EventRecord::Transmission(p1, p2, type, sim_day, id_index_case,
+                                                  p2->GetHealth().GetRelativeInfectiousness()));
         }
 };
 
@@ -98,33 +89,19 @@ template <>
 class LOG_POLICY<EventLogMode::Id::All>
 {
 public:
-        static void Contact(const std::shared_ptr<spdlog::logger>& logger, const Person* p1, const Person* p2,
-                            ContactType::Id type, unsigned short int sim_day, const double cProb, const double tProb)
+        static void Contact(EventLog& log, const Person* p1, const Person* p2, ContactType::Id type,
+                            unsigned short int sim_day, const double cProb, const double tProb)
         {
                 if (p1->IsSurveyParticipant()) {
-                        logger->info("[CONT] {} {} {} {} {} {} {} {} {} {} {} {} {} {} {} {}", p1->GetId(), p1->GetAge(),
-                                     p2->GetAge(), static_cast<unsigned int>(type == ContactType::Id::Household),
-                                     static_cast<unsigned int>(type == ContactType::Id::K12School),
-                                     static_cast<unsigned int>(type == ContactType::Id::College),
-                                     static_cast<unsigned int>(type == ContactType::Id::Workplace),
-                                     static_cast<unsigned int>(type == ContactType::Id::PrimaryCommunity),
-                                     static_cast<unsigned int>(type == ContactType::Id::SecondaryCommunity),
-									 static_cast<unsigned int>(type == ContactType::Id::HouseholdCluster),
-									 static_cast<unsigned int>(type == ContactType::Id::Collectivity),
-									 sim_day,
-									 cProb, tProb,p2->GetHealth().IsSymptomatic(),p1->GetHealth().IsSymptomatic());
+                        log.Log(EventRecord::Contact(p1, p2, type, sim_day, cProb, tProb));
                 }
         }
 
-        static void Trans(const std::shared_ptr<spdlog::logger>& logger, const Person* p1, const Person* p2,
-                          ContactType::Id type, unsigned short int sim_day, unsigned int id_index_case)
+        static void Trans(EventLog& log, const Person* p1, const Person* p2, ContactType::Id type,
+                          unsigned short int sim_day, unsigned int id_index_case)
         {
-                logger->info("[TRAN] {} {} {} {} {} {} {} {} {} {} {} {} {} {}", p2->GetId(), p1->GetId(), p2->GetAge(), p1->GetAge(),
-                             ToString(type), sim_day, id_index_case,
-							 p2->GetHealth().GetStartInfectiousness(),p2->GetHealth().GetEndInfectiousness(),
-							 p2->GetHealth().GetStartSymptomatic(),p2->GetHealth().GetEndSymptomatic(),
-							 p1->GetHealth().IsSymptomatic(),  p1->GetHealth().GetRelativeInfectiousness(),
-							 p2->GetHealth().GetRelativeSusceptibility());
+                log.Log(EventRecord::Transmission(p1, p2, type, sim_day, id_index_case,
+                                                  p1->GetHealth().GetRelativeInfectiousness()));
         }
 };
 
@@ -136,115 +113,37 @@ using namespace stride;
 using namespace stride::ContactType;
 using namespace stride::util;
 
-inline double GetContactProbability(const AgeContactProfile& profile, const Person* p1, const Person* p2,
-		size_t pool_size, const ContactType::Id pType, const unsigned min_age_members,
-		std::shared_ptr<Population>& population, double cnt_intensity_householdCluster,std::shared_ptr<Calendar> calendar)
-{
-
-		// initiate a contact adjustment factor, to account for physical distancing and/or contact intensity
-    	double cnt_adjustment_factor = 1;
-
-    		// Check if one of the persons is a non-complier to social distancing measures in this particular pooltype
-    		if ((not p1->IsNonComplier(pType)) and (not p2->IsNonComplier(pType))) {
-
-    			// account for physical distancing at work
-    			if(pType == Id::Workplace){
-
-    				double workplace_distancing_factor = calendar->GetWorkplaceDistancingFactor();
-    				cnt_adjustment_factor = (1-workplace_distancing_factor);
-    			}
-
-    			// account for physical distancing in the community
-    			if((pType == Id::PrimaryCommunity || pType == Id::SecondaryCommunity)){
-
-    				double community_distancing_factor = calendar->GetCommunityDistancingFactor();
-   					cnt_adjustment_factor = (1-community_distancing_factor);
-    			}
-
-    			// account for physical distancing at school
-    			if(pType == Id::K12School || pType == Id::College){
-
-    				double school_distancing_factor = calendar->GetSchoolDistancingFactor(min_age_members) ;
-    				cnt_adjustment_factor = (1-school_distancing_factor);
-    			}
-
-    			// account for physical distancing in the collectivity
-				if(pType == Id::Collectivity){
-
-					double collectivity_distancing_factor = calendar->GetCollectivityDistancingFactor();
-					cnt_adjustment_factor = (1-collectivity_distancing_factor);
-				}
-    		}
-
-
-		// account for contact intensity in household clusters
-		if(pType == Id::HouseholdCluster){
-			cnt_adjustment_factor = cnt_intensity_householdCluster;
-		}
-
-
-		// get the reference number of contacts, given age and age-contact profile
-		double reference_num_contacts_p1{profile[EffectiveAge(static_cast<unsigned int>(p1->GetAge()))]};
-        double reference_num_contacts_p2{profile[EffectiveAge(static_cast<unsigned int>(p2->GetAge()))]};
-        const double potential_num_contacts{static_cast<double>(pool_size - 1)};
-
-        // adjust contact for distancing
-        reference_num_contacts_p1 *= cnt_adjustment_factor;
-        reference_num_contacts_p2 *= cnt_adjustment_factor;
-
+/// Member columns of the pool that is being processed, one per (OpenMP) thread.
+thread_local ContactPoolView t_pool_view;
 
-        // special case: reduce the number of community contacts if part of a HouseholdCluster
-        if(cnt_intensity_householdCluster > 0 && (pType == Id::PrimaryCommunity || pType == Id::SecondaryCommunity)){
-
-        	// get the number of non-household members in the HouseholdCluster
-        	double householdCluster_non_household_members_p1 = static_cast<double>(population->GetPoolSize(Id::HouseholdCluster,p1)) -
-        											                  population->GetPoolSize(Id::Household,p1);
-
-        	double householdCluster_non_household_members_p2 = static_cast<double>(population->GetPoolSize(Id::HouseholdCluster,p2)) -
-        	        											      population->GetPoolSize(Id::Household,p2);
-
-        	// account for negative values ==>> not part of a HouseholdCluster
-        	householdCluster_non_household_members_p1 = householdCluster_non_household_members_p1 < 0 ? 0 : householdCluster_non_household_members_p1;
-        	householdCluster_non_household_members_p2 = householdCluster_non_household_members_p2 < 0 ? 0 : householdCluster_non_household_members_p2;
-
-        	// account for the HouseholdCluster size and contact intensity
-        	reference_num_contacts_p1 -= householdCluster_non_household_members_p1 * cnt_intensity_householdCluster;
-        	reference_num_contacts_p2 -= householdCluster_non_household_members_p2 * cnt_intensity_householdCluster;
+/// Commit the contact registrations and infections proposed in the contact phase.
+/// \tparam RC          Register the contact of the infector with the infectee (contacts are
+///                     not proposed separately by the time-optimized Infector).
+template <EventLogMode::Id LL, bool TIC, bool RC>
+void CommitInfections(unsigned short int simDay, EventLog& eventLog, Population& population)
+{
+        using LP = LOG_POLICY<LL>;
 
-        	// account for negative values
-        	reference_num_contacts_p1 = reference_num_contacts_p1 < 0 ? 0 : reference_num_contacts_p1;
-        	reference_num_contacts_p2 = reference_num_contacts_p2 < 0 ? 0 : reference_num_contacts_p2;
+        auto& buffer    = population.RefInfectionBuffer();
+        auto& registers = population.RefContactRegisters();
+        for (const auto& c : buffer.CollectContacts()) {
+                registers.Register(*c.index_case, *c.contact, simDay);
         }
+        for (const auto& infection : buffer.CollectInfections()) {
+                const auto p1 = infection.infector;
+                const auto p2 = infection.infectee;
+                const auto& h1 = p1->GetHealth();
 
-        // calculate the contact probability based on the (possible) number of contacts
-        double individual_contact_probability_p1 = reference_num_contacts_p1 / potential_num_contacts;
-        double individual_contact_probability_p2 = reference_num_contacts_p2 / potential_num_contacts;
-
-        // use the minimum of both age-specific probabilities
-        double contact_probability = individual_contact_probability_p1 ;
-		if(individual_contact_probability_p2 < individual_contact_probability_p1){
-			contact_probability = individual_contact_probability_p2;
-		}
+                // No secondary infections with TIC; just mark p2 'recovered'
+                population.StartInfection(p2, h1.GetIdIndexCase(), p1->GetId(), infection.relative_infectiousness,
+                                          static_cast<unsigned short int>(simDay + 1U), TIC);
 
+                // if track&trace is in place, option to register the contact
+                if (RC)
+                        registers.Register(*p1, *p2, simDay);
 
-	    // limit probability to 0.999
-        if (contact_probability >= 1) {
-        	contact_probability = 0.999;
+                LP::Trans(eventLog, p1, p2, infection.type, simDay, h1.GetIdIndexCase());
         }
-
-
-    	// assume fully connected households
-		if(pType == Id::Household){
-			contact_probability = 0.999;
-		}
-
-		// exclude contacts with household members within household cluster
-		if(pType == Id::HouseholdCluster){
-			contact_probability = (p1->GetPoolId(Id::Household) == p2->GetPoolId(Id::Household)) ? 0.0 : cnt_intensity_householdCluster;
-		}
-
-
-        return contact_probability;
 }
 
 } // namespace
@@ -256,87 +155,106 @@ using namespace stride::util;
 //-------------------------------------------------------------------------------------------------
 // Definition for ContactLogMode::Contacts,
 // both with track_index_case false and true.
+// Contacts only show (in the log or in a contact register) when one of the persons is recorded,
+// i.e. is a survey participant or a tracing index case. So all contacts are drawn for pairs with
+// a recorded member and only the transmissions (a contact and a transmission in one draw) for
+// the other pairs, as in the time-optimized version. Each pair has the same probability of
+// contact and transmission as when all contacts are drawn.
 //-------------------------------------------------------------------------------------------------
-template <EventLogMode::Id LL, bool TIC, bool TO>
-void Infector<LL, TIC, TO>::Exec(ContactPool& pool, const AgeContactProfile& profile,
+template <EventLogMode::Id LL, bool TIC, bool GS, bool TO>
+void Infector<LL, TIC, GS, TO>::Exec(ContactPool& pool, const ContactPolicy& policy,
                                  const TransmissionProfile& transProfile, util::RnHandler& rnHandler,
-                                 unsigned short int simDay, shared_ptr<spdlog::logger> eventLogger,
-								 std::shared_ptr<Population> population, double m_cnt_intensity_householdCluster,
-								 std::shared_ptr<Calendar> calendar)
+                                 unsigned short int simDay, EventLog& eventLog,
+                                 Population& population)
 {
         using LP = LOG_POLICY<LL>;
 
         // set up some stuff
-        const auto  pType    = pool.m_pool_type;
-        const auto& pMembers = pool.m_members;
-        const auto  pSize    = pMembers.size();
-
-        // get minimum age of the members (relevant for school settings)
-        const unsigned int min_age_members = pool.GetMinAge();
-
-        // check all contacts
-        for (size_t i_person1 = 0; i_person1 < pSize; i_person1++) {
-                // check if member is present today
+        const auto  num_infectious = pool.m_num_infectious;
+        const auto  num_cases      = pool.m_index_susceptible;
+        const auto  pType          = pool.m_pool_type;
+        const auto  pImmune        = pool.m_index_immune;
+        const auto& pMembers       = pool.m_members;
+        const auto  pSize          = pMembers.size();
+        auto&       view           = t_pool_view;
+        auto&       buffer         = population.RefInfectionBuffer();
+        view.Load(pool, pSize, policy);
+        rnHandler.SetKey(simDay, RnHandler::Purpose::Contact, static_cast<unsigned int>(pType), pool.GetId());
+
+        // get the contact adjustment factor for today (depends on the minimum age of the members in school settings)
+        const double cnt_adjustment_factor = policy.GetAdjustmentFactor(pType, pool.GetMinAge());
+
+        // check all contacts of the recorded members (only members that are present today)
+        for (size_t i_person1 = view.NextRecorded(0, pSize); i_person1 < pSize;
+             i_person1 = view.NextRecorded(i_person1 + 1, pSize)) {
                 const auto p1 = pMembers[i_person1];
-                if (!p1->IsInPool(pType)) {
-                        continue;
-                }
-                // loop over possible contacts (contacts can be initiated by each member)
-                for (size_t i_person2 = i_person1 + 1; i_person2 < pSize; i_person2++) {
-                        // check if not the same person
-                        if (i_person1 == i_person2) {
-                                continue;
-                        }
-                        // check if member is present today
-                        const auto p2 = pMembers[i_person2];
-                        if (!p2->IsInPool(pType)) {
+                // loop over possible contacts, the pairs of recorded members only once
+                for (size_t i_person2 = view.NextPresent(0, pSize); i_person2 < pSize;
+                     i_person2 = view.NextPresent(i_person2 + 1, pSize)) {
+                        if (i_person2 == i_person1 || (i_person2 < i_person1 && view.IsRecorded(i_person2))) {
                                 continue;
                         }
                         // check for contact
-                        const double cProb = GetContactProbability(profile, p1, p2, pSize, pType, min_age_members,
-								population,m_cnt_intensity_householdCluster,calendar);
+                        const double cProb = policy.GetContactProbability(view, i_person1, i_person2, pSize, pType,
+								cnt_adjustment_factor);
                         if (rnHandler.Binomial(cProb)) {
+                                const auto  p2             = pMembers[i_person2];
 								const auto  tProb_p1_p2    = transProfile.GetProbability(p1,p2);
 								const auto  tProb_p2_p1    = transProfile.GetProbability(p2,p1);
 
                                 // log contact if person 1 is participating in survey
-                                LP::Contact(eventLogger, p1, p2, pType, simDay, cProb, tProb_p1_p2);
+                                LP::Contact(eventLog, p1, p2, pType, simDay, cProb, tProb_p1_p2);
                                 // log contact if person 2 is participating in survey
-                                LP::Contact(eventLogger, p2, p1, pType, simDay, cProb, tProb_p2_p1);
+                                LP::Contact(eventLog, p2, p1, pType, simDay, cProb, tProb_p2_p1);
 
 
                                 // if track&trace is in place, option to register (both) contact(s)
-                                p1->RegisterContact(p2);
-                                p2->RegisterContact(p1);
-
-                                // transmission & infection.
-                                // note: no tertiary infections with TIC; so mark new case as 'recovered'
-                                auto& h1 = p1->GetHealth();
-                                auto& h2 = p2->GetHealth();
-
-								// if h1 infectious, account for susceptibility of p2
-								if (h1.IsInfectious() && h2.IsSusceptible() &&
-									rnHandler.Binomial(tProb_p1_p2)) {
-
-										double rel_inf = transProfile.GetIndividualInfectiousness(rnHandler);
-										h2.StartInfection(h1.GetIdIndexCase(),p1->GetId(),rel_inf);
-
-										if (TIC)
-												h2.StopInfection();
-										LP::Trans(eventLogger, p1, p2, pType, simDay, h1.GetIdIndexCase());
-								}
-
-								// if h2 infectious, account for susceptibility of p1
-								if (h2.IsInfectious() && h1.IsSusceptible() &&
-									rnHandler.Binomial(tProb_p2_p1)) {
+                                buffer.ProposeContact(p1, p2, pType);
+                                buffer.ProposeContact(p2, p1, pType);
+
+                                // transmission & infection, committed after the contact phase.
+                                // if p1 infectious, account for susceptibility of p2
+                                if (view.IsInfectious(i_person1) && view.IsSusceptible(i_person2) &&
+                                    rnHandler.Binomial(tProb_p1_p2)) {
+                                        double rel_inf = transProfile.GetIndividualInfectiousness(rnHandler);
+                                        buffer.ProposeInfection(p2, p1, pType, rel_inf, rnHandler());
+                                        view.SetStatus(i_person2, HealthStatus::Exposed);
+                                }
 
-									double rel_inf = transProfile.GetIndividualInfectiousness(rnHandler);
-									h1.StartInfection(h2.GetIdIndexCase(),p2->GetId(), rel_inf);
+                                // if p2 infectious, account for susceptibility of p1
+                                if (view.IsInfectious(i_person2) && view.IsSusceptible(i_person1) &&
+                                    rnHandler.Binomial(tProb_p2_p1)) {
+                                        double rel_inf = transProfile.GetIndividualInfectiousness(rnHandler);
+                                        buffer.ProposeInfection(p1, p2, pType, rel_inf, rnHandler());
+                                        view.SetStatus(i_person1, HealthStatus::Exposed);
+                                }
+                        }
+                }
+        }
 
-										if (TIC)
-												h1.StopInfection();
-										LP::Trans(eventLogger, p2, p1, pType, simDay, h2.GetIdIndexCase());
-								}
+        // match infectious and susceptible members that are not recorded (members are partitioned
+        // w.r.t. health status: infectious, other infected, susceptible, recovered/immune)
+        for (size_t i_infected = view.NextPresent(0, num_infectious); i_infected < num_infectious;
+             i_infected = view.NextPresent(i_infected + 1, num_infectious)) {
+                if (view.IsRecorded(i_infected)) {
+                        continue;
+                }
+                const auto   p1       = pMembers[i_infected];
+                const double tProb_p1 = transProfile.GetInfectorProbability(p1);
+                for (size_t i_contact = view.NextPresent(num_cases, pImmune); i_contact < pImmune;
+                     i_contact = view.NextPresent(i_contact + 1, pImmune)) {
+                        if (view.IsRecorded(i_contact) || !view.IsSusceptible(i_contact)) {
+                                continue;
+                        }
+                        const double cProb_p1 = policy.GetContactProbability(view, i_infected, i_contact,
+													pSize, pType, cnt_adjustment_factor);
+                        const double tProb_p1_p2 = transProfile.GetProbability(tProb_p1, view.GetAge(i_contact),
+                                                                               view.GetSusceptibility(i_contact));
+                        if (rnHandler.Binomial(cProb_p1, tProb_p1_p2)) {
+                                // committed after the contact phase
+                                double rel_inf = transProfile.GetIndividualInfectiousness(rnHandler);
+                                buffer.ProposeInfection(pMembers[i_contact], p1, pType, rel_inf, rnHandler());
+                                view.SetStatus(i_contact, HealthStatus::Exposed);
                         }
                 }
         }
@@ -344,68 +262,84 @@ void Infector<LL, TIC, TO>::Exec(ContactPool& pool, const AgeContactProfile& pro
 
 //-------------------------------------------------------------------------------------------
 // Definition for ContactLogMode::None and ContactLogMode::Transmission
-// both with track_index_case false and true.
+// both with track_index_case false and true and with geometric sampling false and true.
 //-------------------------------------------------------------------------------------------
-template <EventLogMode::Id LL, bool TIC>
-void Infector<LL, TIC, true>::Exec(ContactPool& pool, const AgeContactProfile& profile,
+template <EventLogMode::Id LL, bool TIC, bool GS>
+void Infector<LL, TIC, GS, true>::Exec(ContactPool& pool, const ContactPolicy& policy,
                                    const TransmissionProfile& transProfile, util::RnHandler& rnHandler,
-                                   unsigned short int simDay, shared_ptr<spdlog::logger> eventLogger,
-								   std::shared_ptr<Population> population, double m_cnt_intensity_householdCluster,
-								   std::shared_ptr<Calendar> calendar)
+                                   unsigned short int simDay, EventLog&, Population& population)
 {
-        using LP = LOG_POLICY<LL>;
-
-        // check for infected members and sort
-        bool   infectious_cases;
-        size_t num_cases;
-        tie(infectious_cases, num_cases) = pool.SortMembers();
-
-        if (!infectious_cases) {
+        // members are partitioned w.r.t. health status: infectious, other infected, susceptible, recovered/immune
+        const auto num_infectious = pool.m_num_infectious;
+        if (num_infectious == 0) {
                 return;
         }
 
         // set up some stuff
-        const auto  pType    = pool.m_pool_type;
-        const auto  pImmune  = pool.m_index_immune;
-        const auto& pMembers = pool.m_members;
-        const auto  pSize    = pMembers.size();
-
-        // get minimum age of the members (relevant for school settings)
-        const unsigned int min_age_members = pool.GetMinAge();
+        const auto  num_cases = pool.m_index_susceptible;
+        const auto  pType     = pool.m_pool_type;
+        const auto  pImmune   = pool.m_index_immune;
+        const auto& pMembers  = pool.m_members;
+        const auto  pSize     = pMembers.size();
+        auto&       view      = t_pool_view;
+        auto&       buffer    = population.RefInfectionBuffer();
+        view.Load(pool, pImmune, policy);
+        rnHandler.SetKey(simDay, RnHandler::Purpose::Contact, static_cast<unsigned int>(pType), pool.GetId());
+
+        // get the contact adjustment factor for today (depends on the minimum age of the members in school settings)
+        const double cnt_adjustment_factor = policy.GetAdjustmentFactor(pType, pool.GetMinAge());
 
         // match infectious and susceptible members, skip last part (immune members)
-        for (size_t i_infected = 0; i_infected < num_cases; i_infected++) {
-                // check if member is present today
-                const auto p1 = pMembers[i_infected];
-                if (!p1->IsInPool(pType)) {
-                        continue;
-                }
-                auto& h1 = p1->GetHealth();
-                if (h1.IsInfectious()) {
-                        // loop over possible susceptible contacts
-                        for (size_t i_contact = num_cases; i_contact < pImmune; i_contact++) {
+        for (size_t i_infected = view.NextPresent(0, num_infectious); i_infected < num_infectious;
+             i_infected = view.NextPresent(i_infected + 1, num_infectious)) {
+                const auto  p1       = pMembers[i_infected];
+                const double tProb_p1 = transProfile.GetInfectorProbability(p1);
+                if (GS) {
+                        // Bernoulli process over the susceptible members with the upper bound of the
+                        // pair probability, thinned with the actual pair probability when a member is hit.
+                        // Each member is hit independently with the same probability as the per-pair draw.
+                        const double pBound = min(1.0, policy.GetContactProbabilityBound(view, i_infected, pSize, pType)
+                        		* transProfile.GetMaxProbability(p1));
+                        size_t gap = rnHandler.Geometric(pBound);
+                        for (size_t i_contact = num_cases; gap < pImmune - i_contact; i_contact++) {
+                                i_contact += gap;
+                                gap = rnHandler.Geometric(pBound);
+
                                 // check if member is present today
-                                const auto p2 = pMembers[i_contact];
-                                if (!p2->IsInPool(pType)) {
+                                if (!view.IsPresent(i_contact)) {
                                         continue;
                                 }
-                                const double cProb_p1 = GetContactProbability(profile, p1, p2, pSize, pType, min_age_members,
-															population, m_cnt_intensity_householdCluster,calendar);
-                                const auto  tProb_p1_p2   = transProfile.GetProbability(p1,p2);
+                                const double cProb_p1 = policy.GetContactProbability(view, i_infected, i_contact,
+															pSize, pType, cnt_adjustment_factor);
+                                const double tProb_p1_p2 = transProfile.GetProbability(tProb_p1, view.GetAge(i_contact),
+                                                                                       view.GetSusceptibility(i_contact));
+                                if (rnHandler.Binomial(cProb_p1 * tProb_p1_p2 / pBound)) {
+
+                                        if (view.IsSusceptible(i_contact)) {
+                                                // committed after the contact phase
+                                                double rel_inf = transProfile.GetIndividualInfectiousness(rnHandler);
+                                                buffer.ProposeInfection(pMembers[i_contact], p1, pType, rel_inf,
+                                                                        rnHandler());
+                                                view.SetStatus(i_contact, HealthStatus::Exposed);
+                                        }
+                                }
+                        }
+                } else {
+                        // loop over possible susceptible contacts that are present today
+                        for (size_t i_contact = view.NextPresent(num_cases, pImmune); i_contact < pImmune;
+                             i_contact = view.NextPresent(i_contact + 1, pImmune)) {
+                                const double cProb_p1 = policy.GetContactProbability(view, i_infected, i_contact,
+															pSize, pType, cnt_adjustment_factor);
+                                const double tProb_p1_p2 = transProfile.GetProbability(tProb_p1, view.GetAge(i_contact),
+                                                                                       view.GetSusceptibility(i_contact));
                                 if (rnHandler.Binomial(cProb_p1, tProb_p1_p2)) {
 
-                                        auto& h2 = p2->GetHealth();
-                                        if (h1.IsInfectious() && h2.IsSusceptible()) {
+                                        if (view.IsSusceptible(i_contact)) {
+                                                // committed after the contact phase
                                                 double rel_inf = transProfile.GetIndividualInfectiousness(rnHandler);
-                                                h2.StartInfection(h1.GetIdIndexCase(),p1->GetId(), rel_inf);
-
-                                                // if track&trace is in place, option to register (both) contact(s)
-                                                p1->RegisterContact(p2); //TODO: make use of "log policy" template
-
-                                                // No secondary infections with TIC; just mark p2 'recovered'
-                                                if (TIC)
-                                                        h2.StopInfection();
-                                                LP::Trans(eventLogger, p1, p2, pType, simDay, h1.GetIdIndexCase());
+                                                buffer.ProposeInfection(pMembers[i_contact], p1, pType, rel_inf,
+                                                                        rnHandler());
+                                                view.SetStatus(i_contact, HealthStatus::Exposed);
                                         }
                                 }
                         }
@@ -413,17 +347,39 @@ void Infector<LL, TIC, true>::Exec(ContactPool& pool, const AgeContactProfile& p
         }
 }
 
+template <EventLogMode::Id LL, bool TIC, bool GS, bool TO>
+void Infector<LL, TIC, GS, TO>::Commit(unsigned short int simDay, EventLog& eventLog,
+                                   Population& population)
+{
+        CommitInfections<LL, TIC, false>(simDay, eventLog, population);
+}
+
+template <EventLogMode::Id LL, bool TIC, bool GS>
+void Infector<LL, TIC, GS, true>::Commit(unsigned short int simDay, EventLog& eventLog,
+                                     Population& population)
+{
+        CommitInfections<LL, TIC, true>(simDay, eventLog, population);
+}
+
 //--------------------------------------------------------------------------
 // All explicit instantiations.
 //--------------------------------------------------------------------------
-template class Infector<EventLogMode::Id::None, false>;
-template class Infector<EventLogMode::Id::None, true>;
-template class Infector<EventLogMode::Id::Incidence, false>;
-template class Infector<EventLogMode::Id::Incidence, true>;
-template class Infector<EventLogMode::Id::Transmissions, false>;
-template class Infector<EventLogMode::Id::Transmissions, true>;
-template class Infector<EventLogMode::Id::All, false>;
-template class Infector<EventLogMode::Id::All, true>;
+template class Infector<EventLogMode::Id::None, false, false>;
+template class Infector<EventLogMode::Id::None, true, false>;
+template class Infector<EventLogMode::Id::Incidence, false, false>;
+template class Infector<EventLogMode::Id::Incidence, true, false>;
+template class Infector<EventLogMode::Id::Transmissions, false, false>;
+template class Infector<EventLogMode::Id::Transmissions, true, false>;
+template class Infector<EventLogMode::Id::All, false, false>;
+template class Infector<EventLogMode::Id::All, true, false>;
+template class Infector<EventLogMode::Id::None, false, true>;
+template class Infector<EventLogMode::Id::None, true, true>;
+template class Infector<EventLogMode::Id::Incidence, false, true>;
+template class Infector<EventLogMode::Id::Incidence, true, true>;
+template class Infector<EventLogMode::Id::Transmissions, false, true>;
+template class Infector<EventLogMode::Id::Transmissions, true, true>;
+template class Infector<EventLogMode::Id::All, false, true>;
+template class Infector<EventLogMode::Id::All, true, true>;
 
 
 } // namespace stride
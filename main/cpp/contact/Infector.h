@@ -20,15 +20,12 @@
 
 #pragma once
 
-#include "calendar/Calendar.h"
-#include "contact/AgeContactProfile.h"
+#include "contact/ContactPolicy.h"
 #include "contact/EventLogMode.h"
 #include "disease/TransmissionProfile.h"
 #include "pop/Population.h"
 #include "util/RnHandler.h"
 
-#include <memory>
-#include <spdlog/spdlog.h>
 
 
 
@@ -74,40 +71,55 @@ class ContactPool;
 /// Actual contacts and transmission in contactpool (primary template).
 /// \tparam LL          LogLevel
 /// \tparam TIC         TrackIndexCase
+/// \tparam GS          GeometricSampling (only used by the time-optimized version)
 /// \tparam TO          TransmissionOptimization
-template <EventLogMode::Id LL, bool TIC, bool TO = UseOptimizedInfector<LL>::value>
+template <EventLogMode::Id LL, bool TIC, bool GS = false, bool TO = UseOptimizedInfector<LL>::value>
 class Infector
 {
 public:
         ///
-        static void Exec(ContactPool& pool, const AgeContactProfile& profile, const TransmissionProfile& transProfile,
-        				 util::RnHandler& rnHandler, unsigned short int simDay, std::shared_ptr<spdlog::logger> eventLogger,
-						 std::shared_ptr<Population> population, double m_cnt_intensity_householdCluster,
-						 std::shared_ptr<Calendar> calendar);
+        static void Exec(ContactPool& pool, const ContactPolicy& policy, const TransmissionProfile& transProfile,
+        				 util::RnHandler& rnHandler, unsigned short int simDay, EventLog& eventLog,
+        				 Population& population);
+
+        /// Commit the infections that Exec proposed in the pools of the day.
+        static void Commit(unsigned short int simDay, EventLog& eventLog, Population& population);
 };
 
 /// Time-optimized version (For None || Transmission logging).
 /// \tparam LL          LogLevel
 /// \tparam TIC         TrackIndexCase
-template <EventLogMode::Id LL, bool TIC>
-class Infector<LL, TIC, true>
+/// \tparam GS          GeometricSampling: skip over susceptibles with geometric draws
+///                     instead of one binomial draw per infectious/susceptible pair.
+template <EventLogMode::Id LL, bool TIC, bool GS>
+class Infector<LL, TIC, GS, true>
 {
 public:
         ///
-        static void Exec(ContactPool& pool, const AgeContactProfile& profile, const TransmissionProfile& transProfile,
-        				 util::RnHandler& rnHandler, unsigned short int simDay, std::shared_ptr<spdlog::logger> eventLogger,
-						 std::shared_ptr<Population> population, double m_cnt_intensity_householdCluster,
-						 std::shared_ptr<Calendar> calendar);
+        static void Exec(ContactPool& pool, const ContactPolicy& policy, const TransmissionProfile& transProfile,
+        				 util::RnHandler& rnHandler, unsigned short int simDay, EventLog& eventLog,
+        				 Population& population);
+
+        /// Commit the infections that Exec proposed in the pools of the day.
+        static void Commit(unsigned short int simDay, EventLog& eventLog, Population& population);
 };
 
 /// Explicit instantiations in cpp file.
-extern template class Infector<EventLogMode::Id::None, false>;
-extern template class Infector<EventLogMode::Id::None, true>;
-extern template class Infector<EventLogMode::Id::Incidence, false>;
-extern template class Infector<EventLogMode::Id::Incidence, true>;
-extern template class Infector<EventLogMode::Id::Transmissions, false>;
-extern template class Infector<EventLogMode::Id::Transmissions, true>;
-extern template class Infector<EventLogMode::Id::All, false>;
-extern template class Infector<EventLogMode::Id::All, true>;
+extern template class Infector<EventLogMode::Id::None, false, false>;
+extern template class Infector<EventLogMode::Id::None, true, false>;
+extern template class Infector<EventLogMode::Id::Incidence, false, false>;
+extern template class Infector<EventLogMode::Id::Incidence, true, false>;
+extern template class Infector<EventLogMode::Id::Transmissions, false, false>;
+extern template class Infector<EventLogMode::Id::Transmissions, true, false>;
+extern template class Infector<EventLogMode::Id::All, false, false>;
+extern template class Infector<EventLogMode::Id::All, true, false>;
+extern template class Infector<EventLogMode::Id::None, false, true>;
+extern template class Infector<EventLogMode::Id::None, true, true>;
+extern template class Infector<EventLogMode::Id::Incidence, false, true>;
+extern template class Infector<EventLogMode::Id::Incidence, true, true>;
+extern template class Infector<EventLogMode::Id::Transmissions, false, true>;
+extern template class Infector<EventLogMode::Id::Transmissions, true, true>;
+extern template class Infector<EventLogMode::Id::All, false, true>;
+extern template class Infector<EventLogMode::Id::All, true, true>;
 
 } // namespace stride
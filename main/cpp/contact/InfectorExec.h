@@ -20,15 +20,13 @@
 
 #pragma once
 
-#include <spdlog/spdlog.h>
-
 namespace stride {
 
-class Calendar;
+class ContactPolicy;
 class ContactPool;
-class AgeContactProfile;
-class TransmissionProfile;
+class EventLog;
 class Population;
+class TransmissionProfile;
 
 namespace util {
 
@@ -37,10 +35,13 @@ class RnHandler;
 }
 
 /// For use in the InfectorMap and Sim; executes infector.
-typedef void(InfectorExec)(ContactPool& pool, const AgeContactProfile& profile,
+typedef void(InfectorExec)(ContactPool& pool, const ContactPolicy& policy,
                            const TransmissionProfile& trans_profile, util::RnHandler& rnHandler,
-                           unsigned short int sim_day, std::shared_ptr<spdlog::logger> event_logger,
-						   std::shared_ptr<Population> population, double m_cnt_intensity_householdCluster,
-						   std::shared_ptr<Calendar> calendar);
+                           unsigned short int sim_day, EventLog& event_log,
+                           Population& population);
+
+/// For use in the InfectorMap and Sim; commits the infections proposed by the infector.
+typedef void(InfectorCommit)(unsigned short int sim_day, EventLog& event_log,
+                             Population& population);
 
 } // namespace stride
@@ -35,30 +35,40 @@ class Calendar;
 class Population;
 
 /**
- * Mechanism to select the appropriate Infector template to execute.
+ * Mechanism to select the appropriate Infector template to execute,
+ * with the matching commit of the infections it proposes.
  */
-class InfectorMap : public std::map<std::tuple<stride::EventLogMode::Id, bool>, InfectorExec*>
+class InfectorMap
+    : public std::map<std::tuple<stride::EventLogMode::Id, bool, bool>, std::pair<InfectorExec*, InfectorCommit*>>
 {
 public:
         /// Fully initialized.
         InfectorMap()
         {
-                Add<true>();
-                Add<false>();
+                Add<true, false>();
+                Add<false, false>();
+                Add<true, true>();
+                Add<false, true>();
         }
 
 private:
         /// Filling up the InfectorMap.
-        template <bool B>
+        /// \tparam B     TrackIndexCase
+        /// \tparam G     GeometricSampling
+        template <bool B, bool G>
         void Add()
         {
                 using namespace EventLogMode;
 
 
-                this->emplace(std::make_pair(std::make_tuple(Id::None, B), &Infector<Id::None, B>::Exec));
-                this->emplace(std::make_pair(std::make_tuple(Id::Incidence, B), &Infector<Id::Incidence, B>::Exec));
-                this->emplace(std::make_pair(std::make_tuple(Id::Transmissions, B), &Infector<Id::Transmissions, B>::Exec));
-                this->emplace(std::make_pair(std::make_tuple(Id::All, B), &Infector<Id::All, B>::Exec));
+                this->emplace(std::make_tuple(Id::None, B, G),
+                              std::make_pair(&Infector<Id::None, B, G>::Exec, &Infector<Id::None, B, G>::Commit));
+                this->emplace(std::make_tuple(Id::Incidence, B, G),
+                              std::make_pair(&Infector<Id::Incidence, B, G>::Exec, &Infector<Id::Incidence, B, G>::Commit));
+                this->emplace(std::make_tuple(Id::Transmissions, B, G),
+                              std::make_pair(&Infector<Id::Transmissions, B, G>::Exec, &Infector<Id::Transmissions, B, G>::Commit));
+                this->emplace(std::make_tuple(Id::All, B, G),
+                              std::make_pair(&Infector<Id::All, B, G>::Exec, &Infector<Id::All, B, G>::Commit));
         }
 };
 
@@ -21,6 +21,7 @@
 #include "DiseaseSeeder.h"
 
 #include "contact/EventLogMode.h"
+#include "pop/EventRecord.h"
 #include "pop/Population.h"
 #include "pop/SurveySeeder.h"
 #include "util/FileSys.h"
@@ -92,35 +93,21 @@ void DiseaseSeeder::ImportInfectedCases(std::shared_ptr<Population> pop, unsigne
         const auto   popSize     = pop->size();
         const auto   maxPopIndex = static_cast<int>(popSize - 1);
         auto         generator   = m_rn_man.GetUniformIntGenerator(0, maxPopIndex, 0U);
-        auto&        logger      = pop->RefEventLogger();
         const EventLogMode::Id log_level   = EventLogMode::ToMode(m_config.get<string>("run.event_log_level", "None"));
 
         while (numInfected > 0) {
                 Person& p = pop->at(static_cast<size_t>(generator()));
                 if (p.GetHealth().IsSusceptible() && (p.GetAge() >= sAgeMin) && (p.GetAge() <= sAgeMax)) {
                         double rel_inf = transProfile.GetIndividualInfectiousness(rnHandler);
-                        p.GetHealth().StartInfection(p.GetId(),0,rel_inf);
+                        pop->StartInfection(&p, p.GetId(), 0U, rel_inf, static_cast<unsigned short int>(simDay));
                         numInfected--;
 
                         //TODO: make use of Infector template functions
                         if (log_level >= EventLogMode::Id::Transmissions) {
-                                logger->info("[PRIM] {} {} {} {} {} {} {} {} {} {} {} {} {} {}",
-                                		p.GetId(), -1, p.GetAge(), -1, -1, simDay, p.GetId(),
-										p.GetHealth().GetStartInfectiousness(),p.GetHealth().GetEndInfectiousness(),
-										p.GetHealth().GetStartSymptomatic(),p.GetHealth().GetEndSymptomatic(), -1,
-										p.GetHealth().GetRelativeInfectiousness(),
-										p.GetHealth().GetRelativeSusceptibility());
-
-                        } else if(log_level == EventLogMode::Id::Incidence){
-                        	{
-								logger->info("[TRAN_M] {} {} {} {} {}",
-											 p.GetAge(),
-											 simDay,
-											 p.GetHealth().GetStartInfectiousness(),
-											 p.GetHealth().GetStartSymptomatic(),
-											 p.GetHealth().GetEndSymptomatic()
-											 );
-							}
+                                pop->RefEventLog().Log(EventRecord::Primary(&p, static_cast<unsigned short int>(simDay)));
+                        } else if (log_level == EventLogMode::Id::Incidence) {
+                                pop->RefEventLog().Log(
+                                    EventRecord::TransmissionIncidence(&p, static_cast<unsigned short int>(simDay)));
                         }
 
                         // register as survey participant
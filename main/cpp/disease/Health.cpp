@@ -22,77 +22,106 @@
 
 #include "util/Assert.h"
 
+#include <algorithm>
+#include <limits>
+#include <stdexcept>
+
 namespace stride {
 
+namespace {
+
+/// Number of days after infection, as stored in Health.
+std::uint8_t ToDays(unsigned int days)
+{
+        if (days > std::numeric_limits<std::uint8_t>::max()) {
+                throw std::runtime_error("Health::Health> Disease stage beyond 255 days after infection.");
+        }
+        return static_cast<std::uint8_t>(days);
+}
+
+} // namespace
+
 Health::Health(unsigned short int start_infectiousness, unsigned short int start_symptomatic,
                unsigned short int time_infectious, unsigned short int time_symptomatic,
 				double sympt_cnt_reduction_work_school, double sympt_cnt_reduction_community,
 				double relative_susceptibility)
-    : m_disease_counter(0U), m_status(HealthStatus::Susceptible), m_start_infectiousness(start_infectiousness),
-      m_start_symptomatic(start_symptomatic), m_end_infectiousness(start_infectiousness + time_infectious),
-      m_end_symptomatic(start_symptomatic + time_symptomatic), m_id_index_case(0U), m_id_infector(0U),
-		m_sympt_cnt_reduction_work_school(sympt_cnt_reduction_work_school),
-		m_sympt_cnt_reduction_community(sympt_cnt_reduction_community),
+    : m_first_day(0U), m_status(HealthStatus::Susceptible), m_start_infectiousness(ToDays(start_infectiousness)),
+      m_start_symptomatic(ToDays(start_symptomatic)), m_end_infectiousness(ToDays(start_infectiousness + time_infectious)),
+      m_end_symptomatic(ToDays(start_symptomatic + time_symptomatic)), m_id_index_case(0U), m_id_infector(0U),
+		m_sympt_cnt_reduction_work_school(static_cast<float>(sympt_cnt_reduction_work_school)),
+		m_sympt_cnt_reduction_community(static_cast<float>(sympt_cnt_reduction_community)),
         m_relative_infectiousness(0U),
 		m_relative_susceptibility(relative_susceptibility)
 {
 }
 
 
-void Health::StartInfection(unsigned int id_index_case, unsigned int id_infector, double relative_infectiousness)
+void Health::StartInfection(unsigned int id_index_case, unsigned int id_infector, double relative_infectiousness,
+                            unsigned short int first_day)
 {
         AssertThrow(m_status == HealthStatus::Susceptible, "Inconsistent Health change", nullptr);
         m_status = HealthStatus::Exposed;
-        ResetDiseaseCounter();
+        m_first_day = first_day;
         m_id_index_case = id_index_case;
         m_id_infector   = id_infector;
         m_relative_infectiousness = relative_infectiousness;
 }
 
-bool Health::NumberDaysSymptomatic(unsigned int days_before) const
+bool Health::NumberDaysSymptomatic(unsigned short int simDay, unsigned int days_before) const
 {
-	return ((GetDiseaseCounter() - days_before ) == m_start_symptomatic) &&
+	return ((GetDiseaseCounter(simDay) - days_before ) == m_start_symptomatic) &&
 			m_start_symptomatic != m_end_symptomatic;
 }
 
-bool Health::NumberDaysInfected(unsigned int days_before) const
+bool Health::NumberDaysInfected(unsigned short int simDay, unsigned int days_before) const
 {
-	return GetDiseaseCounter() == days_before;
+	return GetDiseaseCounter(simDay) == days_before;
 }
 
 void Health::StopInfection()
 {
         AssertThrow(IsInfected(), "Person not infected", nullptr);
         m_status = HealthStatus::Recovered;
-        ResetDiseaseCounter();
 }
 
-void Health::Update()
+unsigned int Health::GetTransitionDays(unsigned short int (&days)[4]) const
+{
+        // The counter never is 0 on an update, so a stage that starts 0 days after infection never fires.
+        unsigned int num_days = 0U;
+        for (unsigned int counter : {m_start_infectiousness, m_start_symptomatic, m_end_symptomatic, m_end_infectiousness}) {
+                if (counter > 0U) {
+                        days[num_days++] = static_cast<unsigned short int>(m_first_day + counter - 1U);
+                }
+        }
+        std::sort(days, days + num_days);
+        return static_cast<unsigned int>(std::unique(days, days + num_days) - days);
+}
+
+void Health::Update(unsigned short int simDay)
 {
         if (IsInfected()) {
-			IncrementDiseaseCounter();
-			if (GetDiseaseCounter() == m_start_infectiousness) {
+			if (GetDiseaseCounter(simDay) == m_start_infectiousness) {
 				if (m_status == HealthStatus::Symptomatic) {
 						m_status = HealthStatus::InfectiousAndSymptomatic;
 				} else {
 						m_status = HealthStatus::Infectious;
 				}
 			}
-			if (GetDiseaseCounter() == m_start_symptomatic) {
+			if (GetDiseaseCounter(simDay) == m_start_symptomatic) {
 				if (m_status == HealthStatus::Infectious) {
 						m_status = HealthStatus::InfectiousAndSymptomatic;
 				} else {
 						m_status = HealthStatus::Symptomatic;
 				}
 			}
-			if (GetDiseaseCounter() == m_end_symptomatic) {
+			if (GetDiseaseCounter(simDay) == m_end_symptomatic) {
 				if (m_status == HealthStatus::InfectiousAndSymptomatic) {
 						m_status = HealthStatus::Infectious;
 				} else if (m_status != HealthStatus::Infectious) {
 					 StopInfection();
 				}
 			}
-			if (GetDiseaseCounter() == m_end_infectiousness) {
+			if (GetDiseaseCounter(simDay) == m_end_infectiousness) {
 				if (m_status == HealthStatus::InfectiousAndSymptomatic) {
 						m_status = HealthStatus::Symptomatic;
 				} else {
@@ -20,10 +20,12 @@
 
 #pragma once
 
+#include <cstdint>
+
 namespace stride {
 
 /// Enumerate the various health states with respect to the infection.
-enum class HealthStatus : unsigned short int
+enum class HealthStatus : std::uint8_t
 {
         Susceptible              = 0U,
         Exposed                  = 1U,
@@ -34,7 +36,13 @@ enum class HealthStatus : unsigned short int
         Immune                   = 6U
 };
 
-/// Holds a person's health data.
+/// Holds a person's health data. Health is part of the hot data of a Person (see Person),
+/// so the data is packed: the disease timing in days after infection in bytes and the
+/// symptomatic contact reductions (model parameters) as floats.
+/// The disease counter (number of days of the disease) is derived from the simulation day
+/// and the first day of the disease, so the health of a person only needs to be updated on
+/// the days its status may change (see GetTransitionDays and Population::UpdateHealth).
+/// The status is changed through the Population (see Population::StartInfection).
 class Health
 {
 public:
@@ -56,12 +64,18 @@ public:
         ///
         unsigned short int GetStartSymptomatic() const { return m_start_symptomatic; }
 
+        /// Simulation day on which the disease counter is 1 (the first day of the disease).
+        unsigned short int GetFirstDay() const { return m_first_day; }
+
         ///
         unsigned int GetIdIndexCase() const { return m_id_index_case; }
 
         ///
         unsigned int GetIdInfector() const { return m_id_infector; }
 
+        /// Get the current health status.
+        HealthStatus GetStatus() const { return m_status; }
+
         /// Is this person immune?
         bool IsImmune() const { return m_status == HealthStatus::Immune; }
 
@@ -97,29 +111,20 @@ public:
 		}
 
         /// Have the symptoms started today?
-        bool SymptomsStartedToday() const { return GetDiseaseCounter() == m_start_symptomatic; }
+        bool SymptomsStartedToday(unsigned short int simDay) const
+        {
+                return GetDiseaseCounter(simDay) == m_start_symptomatic;
+        }
 
         /// Have the symptoms started X days before?
-        bool NumberDaysSymptomatic(unsigned int days_before) const;
+        bool NumberDaysSymptomatic(unsigned short int simDay, unsigned int days_before) const;
 
         /// Is infected X days before?
-        bool NumberDaysInfected(unsigned int days_before) const;
-
-        /// Set health state to immune.
-        void SetImmune() { m_status = HealthStatus::Immune; }
-
-        /// Set health state to susceptible
-        void SetSusceptible() { m_status = HealthStatus::Susceptible; }
-
-        /// Start the infection.
-        void StartInfection(unsigned int id_index_case, unsigned int id_infector, 
-                double relative_infectiousness);
-
-        /// Stop the infection.
-        void StopInfection();
+        bool NumberDaysInfected(unsigned short int simDay, unsigned int days_before) const;
 
-        /// Update progress of the disease.
-        void Update();
+        /// The distinct days on which the status of the infection may change, in increasing order.
+        /// Returns the number of days (at most four) written to the array.
+        unsigned int GetTransitionDays(unsigned short int (&days)[4]) const;
 
         /// Get contact reduction in school/work pools when symptomatic infected
         double GetSymptomaticCntReductionWorkSchool() const { return m_sympt_cnt_reduction_work_school; };
@@ -128,7 +133,10 @@ public:
         double GetSymptomaticCntReductionCommunity() const { return m_sympt_cnt_reduction_community; };
 
 		/// Is this individual PCR detectable?
-		bool IsPcrDetectable(unsigned int detectable_delay) const { return GetDiseaseCounter() >= detectable_delay; }
+		bool IsPcrDetectable(unsigned short int simDay, unsigned int detectable_delay) const
+		{
+				return GetDiseaseCounter(simDay) >= detectable_delay;
+		}
 
         /// Get relative infectiousness
         double GetRelativeInfectiousness() const {
@@ -142,29 +150,49 @@ public:
 
 
 private:
-        /// Get the disease counter.
-        unsigned short int GetDiseaseCounter() const { return m_disease_counter; }
+        /// The health status only changes through the Population, which registers the change
+        /// (the person moves to another partition of its contact pools, see ContactPool).
+        friend class Population;
+
+        /// Changes the health of its private copies of the index cases, which are in no pool.
+        friend class IndexCaseSim;
+
+        /// Set health state to immune.
+        void SetImmune() { m_status = HealthStatus::Immune; }
 
-        /// Increment disease counter.
-        void IncrementDiseaseCounter() { m_disease_counter++; }
+        /// Set health state to susceptible
+        void SetSusceptible() { m_status = HealthStatus::Susceptible; }
 
-        /// Reset the disease counter.
-        void ResetDiseaseCounter() { m_disease_counter = 0U; }
+        /// Start the infection, the disease counter being 1 on the given (simulation) day.
+        void StartInfection(unsigned int id_index_case, unsigned int id_infector,
+                double relative_infectiousness, unsigned short int first_day);
+
+        /// Stop the infection.
+        void StopInfection();
+
+        /// Update progress of the disease on the given day (only changes on the transition days).
+        void Update(unsigned short int simDay);
+
+        /// Get the disease counter on the given day (0 when not infected).
+        unsigned short int GetDiseaseCounter(unsigned short int simDay) const
+        {
+                return IsInfected() ? static_cast<unsigned short int>(simDay + 1U - m_first_day) : 0U;
+        }
 
 private:
-        unsigned short int m_disease_counter; ///< The disease counter.
+        unsigned short int m_first_day;       ///< Simulation day on which the disease counter is 1.
         HealthStatus       m_status;          ///< The current status of the person w.r.t. the disease.
 
-        unsigned short int m_start_infectiousness; ///< Days after infection to become infectious.
-        unsigned short int m_start_symptomatic;    ///< Days after infection to become symptomatic.
-        unsigned short int m_end_infectiousness;   ///< Days after infection to end infectious state.
-        unsigned short int m_end_symptomatic;      ///< Days after infection to end symptomatic state.
+        std::uint8_t       m_start_infectiousness; ///< Days after infection to become infectious.
+        std::uint8_t       m_start_symptomatic;    ///< Days after infection to become symptomatic.
+        std::uint8_t       m_end_infectiousness;   ///< Days after infection to end infectious state.
+        std::uint8_t       m_end_symptomatic;      ///< Days after infection to end symptomatic state.
 
         unsigned int       m_id_index_case;        ///< ID of the index case, given infection
         unsigned int       m_id_infector;          ///< ID of the infector, given infection
 
-        double             m_sympt_cnt_reduction_work_school;  ///< Proportional reduction of presence in work/school pool when symptomatic
-        double             m_sympt_cnt_reduction_community;    ///< Proportional reduction of presence in the community pools when symptomatic
+        float              m_sympt_cnt_reduction_work_school;  ///< Proportional reduction of presence in work/school pool when symptomatic
+        float              m_sympt_cnt_reduction_community;    ///< Proportional reduction of presence in the community pools when symptomatic
 
         double			   m_relative_infectiousness;   ///< Relative probability of transmission when infected [0-1]
         double			   m_relative_susceptibility;   ///< Relative probability of acquiring infection upon exposure [0-1]
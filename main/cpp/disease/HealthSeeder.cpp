@@ -92,6 +92,7 @@ void HealthSeeder::Seed(const std::shared_ptr<stride::Population>& pop, const Tr
                 auto& gen01 = handlers[static_cast<size_t>(omp_get_thread_num())];
 #pragma omp for
                 for (size_t i = 0; i < population.size(); ++i) {
+                        gen01.SetKey(0U, util::RnHandler::Purpose::HealthSeeding, 0U, population[i].GetId());
 
                 		// initiate start for symptomatic and infectious period
                 		auto startSymptomatic          = 0;
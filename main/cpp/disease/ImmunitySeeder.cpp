@@ -160,7 +160,7 @@ void ImmunitySeeder::Random(const SegmentedVector<ContactPool>& pools, vector<do
                         Person& p = *p_pool[indices[i_p]];
                         // if p is susceptible and his/her age class has not reached the quota => make immune
                         if (p.GetHealth().IsSusceptible() && populationBrackets[p.GetAge()] > 0) {
-                                p.GetHealth().SetImmune();
+                                pop->SetImmune(&p);
 
                                 populationBrackets[p.GetAge()]--;
                                 numImmune--;
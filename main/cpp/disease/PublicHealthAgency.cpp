@@ -22,12 +22,14 @@
 
 #include "calendar/Calendar.h"
 #include "pop/Population.h"
+#include "sim/TimingWheel.h"
 #include "util/FileSys.h"
 #include "util/LogUtils.h"
 #include "util/StringUtils.h"
 
 #include <boost/property_tree/ptree.hpp>
 #include <algorithm>
+#include <omp.h>
 
 namespace stride {
 
@@ -39,7 +41,7 @@ using namespace std;
 // Default constructor
 PublicHealthAgency::PublicHealthAgency(): m_detection_probability(0),
 		m_tracing_efficiency_household(0),m_tracing_efficiency_other(0),m_case_finding_capacity(0),m_delay_isolation_index(0),m_delay_contact_tracing(0),
-		m_test_false_negative(0)
+		m_test_false_negative(0), m_index_cases(1)
 	{}
 
 void PublicHealthAgency::Initialize(const ptree& config){
@@ -58,6 +60,9 @@ void PublicHealthAgency::Initialize(const ptree& config){
 	m_detection_probability        *= (1.0 - m_test_false_negative);
 	m_tracing_efficiency_household  *= (1.0 - m_test_false_negative);
 	m_tracing_efficiency_other      *= (1.0 - m_test_false_negative);
+
+	// index cases are queued at most 255 + delay days ahead (see PerformContactTracing)
+	m_index_cases.assign(256U + m_delay_isolation_index, vector<Person*>());
 }
 
 bool PublicHealthAgency::IsContactTracingActive(const std::shared_ptr<Calendar> calendar) const {
@@ -65,104 +70,101 @@ bool PublicHealthAgency::IsContactTracingActive(const std::shared_ptr<Calendar>
 }
 
 
-void PublicHealthAgency::PerformContactTracing(std::shared_ptr<Population> pop, RnHandler& rnHandler,
-												const std::shared_ptr<Calendar> calendar)
+void PublicHealthAgency::PerformContactTracing(std::shared_ptr<Population> pop, std::vector<RnHandler>& rnHandlers,
+												const std::shared_ptr<Calendar> calendar, TimingWheel& personEvents)
 {
+	const auto simDay = calendar->GetSimulationDay();
+	auto&      queue  = m_index_cases[simDay % m_index_cases.size()];
 
-	// if contact tracing not active, stop
+	// if contact tracing not active, stop (today's index cases are not traced)
 	if (!IsContactTracingActive(calendar)) {
+			queue.clear();
 			return;
 	}
 
-	//cout << m_detection_probability << " -- "<< m_tracing_efficiency_household << " -- "<< m_tracing_efficiency_other << " ** " << m_case_finding_capacity << endl;
-
-
-	/// Mark index cases for track&trace
-	for (auto& p_case : *pop) {
-
-		if(p_case.GetHealth().NumberDaysInfected(1) &&
-				rnHandler.Binomial(m_detection_probability)) {
-			p_case.SetTracingIndexCase();
+	/// Mark index cases for track&trace on the first day of their disease and queue
+	/// them for day X after symptom onset (the disease counter is at most 255).
+	auto& rnHandler = rnHandlers[0];
+	for (const auto p_case : pop->CRefOnsets(simDay)) {
+		const auto& h = p_case->GetHealth();
+		if (h.NumberDaysInfected(simDay, 1) && rnHandler.Binomial(m_detection_probability)) {
+			p_case->SetTracingIndexCase();
+			const unsigned int counter = h.GetStartSymptomatic() + m_delay_isolation_index;
+			if (counter > 0U && h.GetStartSymptomatic() != h.GetEndSymptomatic()) {
+				m_index_cases[(h.GetFirstDay() + counter - 1U) % m_index_cases.size()].emplace_back(p_case);
+			}
 		}
-
 	}
 
-	/// Set counter for index cases
-	unsigned int num_index_cases = 0;
-
-	/// Loop over the population to find index cases on day X after symptom onset
-	for (auto& p_case : *pop) {
-
-		if (p_case.IsTracingIndexCase() && p_case.GetHealth().NumberDaysSymptomatic(m_delay_isolation_index)	) {
-        Trace(p_case, pop, rnHandler, calendar);
-
-        // update index case counter, and terminate if quota is reached
-        num_index_cases++;
-        if(num_index_cases >= m_case_finding_capacity){
-            return;
-        }
-       } 
+	/// Select today's index cases (still on day X after symptom onset) in order of id,
+	/// until the quota is reached
+	sort(queue.begin(), queue.end(), [](const Person* p1, const Person* p2) { return p1->GetId() < p2->GetId(); });
+	vector<Person*> index_cases;
+	for (const auto p_case : queue) {
+		if (p_case->GetHealth().NumberDaysSymptomatic(simDay, m_delay_isolation_index)) {
+			index_cases.emplace_back(p_case);
+			if (index_cases.size() >= m_case_finding_capacity) {
+				break;
+			}
+		}
+	}
+	queue.clear();
+
+	/// Trace the index cases in parallel, then schedule the isolations in order
+	const auto num_cases = static_cast<long>(index_cases.size());
+	vector<vector<Isolation>> isolations(index_cases.size());
+#pragma omp parallel for num_threads(static_cast<int>(rnHandlers.size())) schedule(static)
+	for (long i = 0; i < num_cases; i++) {
+		auto& handler = rnHandlers[static_cast<size_t>(omp_get_thread_num())];
+		auto& p_case  = *index_cases[static_cast<size_t>(i)];
+		handler.SetKey(simDay, RnHandler::Purpose::TraceIndexCase, 0U, p_case.GetId());
+		Trace(p_case, *pop, handler, simDay, isolations[static_cast<size_t>(i)]);
+	}
+	for (const auto& case_isolations : isolations) {
+		for (const auto& isolation : case_isolations) {
+			personEvents.Isolate(simDay, isolation.person, isolation.from, isolation.to);
+		}
 	}
 }
 
-//TODO: rename IsolateAndTrace()
-void PublicHealthAgency::Trace(Person& p_case, 
-        std::shared_ptr<Population> pop, 
-		RnHandler& rnHandler,
-        const std::shared_ptr<Calendar> calendar)
+void PublicHealthAgency::Trace(Person& p_case, Population& pop, RnHandler& rnHandler, unsigned short int simDay,
+		vector<Isolation>& isolations) const
 {
-	auto& logger       = pop->RefEventLogger();
-	const auto  simDay = calendar->GetSimulationDay();
-
 			// Set index case in quarantine.
 		    // As this individual tested positive, he/she is isolated for 7 days.
 		     	unsigned int start = simDay + 1; //start tomorrow
-			p_case.Isolate(simDay, start, start+7);
+			isolations.push_back({&p_case, start, start + 7});
 
 			// counter for number of contacts tested
 			unsigned int num_contacts_tested = 0;
 
-			// get contact register and iterator
-			vector<Person*> cnt_register = p_case.GetContactRegister();
-			vector<Person*>::iterator ip;
-
-			// cout << p_case.GetId() << ": size (orig) " <<  cnt_register.size() << endl;
+			// loop over the contacts in the register (each contact once, no sorting needed)
+			const auto num_registered = pop.CRefContactRegisters().ForEach(p_case, simDay, [&](unsigned int id) {
 
-			// Sorting the vector, get the unique elements, and remove the others
-			std::sort(cnt_register.begin(), cnt_register.end());
-			ip = std::unique(cnt_register.begin(), cnt_register.end());
-			cnt_register.resize(std::distance(cnt_register.begin(), ip));
-
-			// cout << p_case.GetId() << ": size (unique) " <<  cnt_register.size() << endl;
-
-			// loop over contact register
-			for (ip = cnt_register.begin(); ip != cnt_register.end(); ++ip) {
-
-
-				Person* p_contact = *ip;
+				Person* p_contact = &pop[id];
 
 				// combine contact tracing efficiency and false negative rate
 				double tracing_efficiency = m_tracing_efficiency_other;
 
 				// set default poolType as "other
-				std::string poolTypeString = "School";
+				EventRecord::TracePlace place = EventRecord::TracePlace::School;
 
 				// if contact is part of same household, change tracing efficiency and poolType
 				if(p_contact->GetPoolId(Id::Household) == p_case.GetPoolId(Id::Household)){
-					poolTypeString    = ToString(Id::Household);
+					place              = EventRecord::TracePlace::Household;
 					tracing_efficiency = m_tracing_efficiency_household;
 				}
 
 				// if contact is part of same community, change poolType
 				if(p_contact->GetPoolId(Id::PrimaryCommunity) == p_case.GetPoolId(Id::PrimaryCommunity)||
 						p_contact->GetPoolId(Id::SecondaryCommunity) == p_case.GetPoolId(Id::SecondaryCommunity)){
-					poolTypeString    = "Community";
+					place = EventRecord::TracePlace::Community;
 				}
 
 				// if contact is part of same workplace, change poolType
 				if(p_case.GetPoolId(Id::Workplace) != 0 &&
 						p_contact->GetPoolId(Id::Workplace) == p_case.GetPoolId(Id::Workplace)){
-					poolTypeString    = "Workplace";
+					place = EventRecord::TracePlace::Workplace;
 				}
 
 				if(rnHandler.Binomial(tracing_efficiency)){
@@ -170,29 +172,19 @@ void PublicHealthAgency::Trace(Person& p_case,
 					if(p_contact->GetHealth().IsInfected()){
 						// start isolation over X days
 					    unsigned int start = simDay + m_delay_contact_tracing;
-						p_contact->Isolate(simDay, start, start + 7);
+						isolations.push_back({p_contact, start, start + 7});
 
 						// add to log (TODO: check log_level)
-						logger->info("[TRACE] {} {} {} {} {} {} {} {} {} {}",
-								p_contact->GetId(), p_contact->GetAge(),
-								p_contact->GetHealth().IsInfected(),
-								p_contact->GetHealth().IsSymptomatic(),
-								poolTypeString, p_case.GetId(),
-								p_case.GetAge(), simDay, -1, -1);
+						pop.RefEventLog().Log(EventRecord::Trace(p_contact, place, &p_case, simDay));
 					}
 					// increment contact counter
 					num_contacts_tested++;
 				}
-			}
+			});
 
 			// Log index case
 			// TODO: check log_level
-			logger->info("[TRACE] {} {} {} {} {} {} {} {} {} {}",
-						 p_case.GetId(), p_case.GetAge(),
-						 p_case.GetHealth().IsInfected(),
-						 p_case.GetHealth().IsSymptomatic(),
-						 "Index", p_case.GetId(),
-						 p_case.GetAge(), simDay, cnt_register.size(), num_contacts_tested);
+			pop.RefEventLog().Log(EventRecord::TraceIndex(&p_case, simDay, num_registered, num_contacts_tested));
 }
 
 } // namespace stride
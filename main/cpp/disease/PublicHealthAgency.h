@@ -28,15 +28,22 @@
 
 #include <boost/property_tree/ptree_fwd.hpp>
 #include <memory>
+#include <vector>
 
 namespace stride {
 
 class Calendar;
 class Population;
 class Sim;
+class TimingWheel;
 
 /**
  * Sets intervention measures.
+ * Contact tracing does not scan the population: the persons whose disease starts today
+ * (see Population::CRefOnsets) may be detected as index case, and are then queued for
+ * the day on which they are traced. The index cases of a day are traced in order of id,
+ * up to the case finding capacity, in parallel: each with its own key for the random
+ * numbers (see RnHandler::SetKey). The isolations are scheduled afterwards, in order.
  */
 class PublicHealthAgency
 {
@@ -48,18 +55,30 @@ public:
 		void Initialize(const boost::property_tree::ptree& config);
 
         /// Public Health Strategy: look for contacts of infected cases and quarantine infected cases
-		void PerformContactTracing(std::shared_ptr<Population> pop, util::RnHandler& rnHandler, const std::shared_ptr<Calendar> calendar);
+		void PerformContactTracing(std::shared_ptr<Population> pop, std::vector<util::RnHandler>& rnHandlers,
+				const std::shared_ptr<Calendar> calendar, TimingWheel& personEvents);
 
 		bool IsK12SchoolOff(unsigned int age, bool isPreSchoolOff, bool isPrimarySchoolOff, bool isSecondarySchoolOff, bool isCollegeOff);
 
 		/// Is Contact tracing active today?
 		bool IsContactTracingActive(const std::shared_ptr<Calendar> calendar) const;
 
-        /// Trace one individual
-        void Trace(Person& p_case,
-                std::shared_ptr<Population> pop,
-				util::RnHandler& rnHandler,
-                const std::shared_ptr<Calendar> calendar);
+        /// Isolation of a person from day 'from' up to day 'to'.
+        struct Isolation
+        {
+                Person*      person;
+                unsigned int from;
+                unsigned int to;
+        };
+
+        /// Trace the contacts of one index case and log the events. The isolations of the index case
+        /// and of its traced (infected) contacts are collected, not scheduled. Can run in parallel.
+        void Trace(Person& p_case, Population& pop, util::RnHandler& rnHandler, unsigned short int simDay,
+                std::vector<Isolation>& isolations) const;
+
+private:
+        /// Saves and restores the queued index cases.
+        friend class SimCheckpoint;
 
 private:
         //contact tracing configuration
@@ -70,6 +89,8 @@ private:
         unsigned int m_delay_isolation_index;         ///< Number of days after symptom onset to perform a clinical test
         unsigned int m_delay_contact_tracing; ///< Number of days after clinical test to start contact tracing
 		double m_test_false_negative;         ///< False negative rate of PCR tests
+
+        std::vector<std::vector<Person*>> m_index_cases; ///< Index cases to trace, per day modulo size.
 };
 
 } // namespace stride
@@ -22,6 +22,7 @@
 
 #include "util/StringUtils.h"
 
+#include <algorithm>
 #include <cmath>
 #include <boost/math/distributions/gamma.hpp>
 
@@ -117,6 +118,9 @@ void TransmissionProfile::Initialize(const ptree& configPt, const ptree& disease
     		m_transmission_probability_distribution_overdispersion = configPt.get<double>("run.transmission_probability_distribution_overdispersion");
     }
 
+    // Store the maximum susceptibility, to bound the transmission probability
+    m_max_susceptibility = *max_element(m_susceptibility_age.begin(), m_susceptibility_age.end());
+
 
 }
 
@@ -155,6 +159,29 @@ double TransmissionProfile::GetProbability(Person* p_infected, Person* p_suscept
 	return transmission_probability_infector * adjustment_asymptomatic * adjustment_susceptible_child * adjustment_susceptible_age;
 }
 
+double TransmissionProfile::GetInfectorProbability(const Person* p_infected) const {
+	// Get individual transmission probability of infector
+	double transmission_probability_infector = p_infected->GetHealth().GetRelativeInfectiousness();
+
+	// Adjustment for asymptomatic cases
+	double adjustment_asymptomatic = (p_infected->GetHealth().IsSymptomatic()) ? 1 : m_rel_transmission_asymptomatic;
+
+	return transmission_probability_infector * adjustment_asymptomatic;
+}
+
+double TransmissionProfile::GetMaxProbability(const Person* p_infected) const {
+	// Get individual transmission probability of infector
+	double transmission_probability_infector = p_infected->GetHealth().GetRelativeInfectiousness();
+
+	// Adjustment for asymptomatic cases
+	double adjustment_asymptomatic = (p_infected->GetHealth().IsSymptomatic()) ? 1 : m_rel_transmission_asymptomatic;
+
+	// Largest adjustment for the susceptible person (children and age-specific susceptibility)
+	double adjustment_susceptible = max(1.0, m_rel_susceptibility_children) * m_max_susceptibility;
+
+	return transmission_probability_infector * adjustment_asymptomatic * adjustment_susceptible;
+}
+
 double TransmissionProfile::GetIndividualInfectiousness(RnHandler& generator) const {
 
 	// If mean transmission probability is 0, return 0.
@@ -40,6 +40,7 @@ public:
 							m_transmission_probability_distribution("Constant"),
 							m_transmission_probability_distribution_overdispersion(0),
 							m_susceptibility_age(100),
+							m_max_susceptibility(1),
 							m_rel_transmission_asymptomatic(1),
 							m_rel_susceptibility_children(1) {}
 
@@ -58,6 +59,21 @@ public:
 	/// Return age-, health-, and person-specific transmission probability.
 	double GetProbability(Person* p_infected, Person* p_susceptible) const;
 
+	/// Return the part of the transmission probability that depends on the infected person.
+	double GetInfectorProbability(const Person* p_infected) const;
+
+	/// Return the transmission probability, given the part of the infected person (see above)
+	/// and the (effective) age and relative susceptibility of the susceptible person.
+	double GetProbability(double infector_probability, unsigned int age_susceptible, double rel_susceptibility) const
+	{
+		const double adjustment_susceptible_child = (age_susceptible < 18) ? m_rel_susceptibility_children : 1;
+		return infector_probability * adjustment_susceptible_child * rel_susceptibility;
+	}
+
+	/// Return upper bound of the transmission probability from the given infected person
+	/// to any susceptible person (used to thin geometric draws in the Infector).
+	double GetMaxProbability(const Person* p_infected) const;
+
 	/// Draw individual transmission probability from distribution.
 	double GetIndividualInfectiousness(util::RnHandler& generator) const;
 
@@ -68,6 +84,7 @@ private:
 	double 						m_transmission_probability_distribution_overdispersion;
 
 	std::vector<double>			m_susceptibility_age;
+	double						m_max_susceptibility;  ///< Maximum of the age-specific susceptibility
 
     double            			m_rel_transmission_asymptomatic; ///< Relative reduction of transmission for asymptomatic cases
     double             			m_rel_susceptibility_children; ///< Relative reduction of susceptibility for children vs. adults
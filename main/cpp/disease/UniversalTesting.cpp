@@ -24,7 +24,7 @@
 
 #include "calendar/Calendar.h"
 #include "pop/Population.h"
-#include "util/Containers.h"
+#include "sim/TimingWheel.h"
 #include "util/CSV.h"
 #include "util/FileSys.h"
 #include "util/LogUtils.h"
@@ -32,6 +32,10 @@
 
 #include <boost/property_tree/ptree.hpp>
 #include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <numeric>
+#include <omp.h>
 #include <stdexcept>
 
 namespace stride {
@@ -49,7 +53,7 @@ UniversalTesting::UniversalTesting():
 	            m_unitest_test_compliance(0.0), m_unitest_isolation_compliance(0.0),
                 m_unitest_isolation_delay(0),
                 m_unitest_detectable_delay(0),
-                m_unitest_isolation_strategy("isolate-pool"),
+                m_unitest_isolation_strategy(IsolationStrategy::IsolatePool),
 	            m_unitest_planning(),
 	            m_unitest_day_in_sweep(0)
 	{}
@@ -63,16 +67,24 @@ void UniversalTesting::Initialize(const ptree& config){
     m_unitest_isolation_compliance = config.get<double>("run.unitest_isolation_compliance",0.0);
     m_unitest_isolation_delay      = config.get<int>("run.unitest_isolation_delay",1);
     m_unitest_detectable_delay     = config.get<int>("run.unitest_detectable_delay",2);
-    m_unitest_isolation_strategy   = config.get<std::string>("run.unitest_isolation_strategy","isolate-pool");
     const auto prefix = config.get<string>("run.output_prefix");
     m_unitest_planning_output_fn   = FileSys::BuildPath(prefix, "unitest_planning.csv");
 
+    const auto strategy = config.get<std::string>("run.unitest_isolation_strategy","isolate-pool");
+    if (strategy == "isolate-pool") {
+        m_unitest_isolation_strategy = IsolationStrategy::IsolatePool;
+    } else if (strategy == "trace") {
+        m_unitest_isolation_strategy = IsolationStrategy::Trace;
+    } else {
+        throw std::runtime_error("UniversalTesting::Initialize> Invalid unitest_isolation_strategy: " + strategy);
+    }
+
     Replace(m_unitest_pool_allocation, "$unitest_pool_size", std::to_string(m_unitest_pool_size));
 }
 
 void UniversalTesting::PerformUniversalTesting(std::shared_ptr<Population> pop, 
-        RnHandler& rnHandler, const std::shared_ptr<Calendar> calendar,
-        PublicHealthAgency& pha)
+        std::vector<RnHandler>& rnHandlers, const std::shared_ptr<Calendar> calendar,
+        const PublicHealthAgency& pha, TimingWheel& personEvents)
 {
   if (!calendar->IsUniversalTestingActivated())
     return;
@@ -82,58 +94,181 @@ void UniversalTesting::PerformUniversalTesting(std::shared_ptr<Population> pop,
 
   const auto simDay = calendar->GetSimulationDay();
 
-  if (m_unitest_planning.empty()) {
-    const auto& households = pop->CRefPoolSys().CRefPools(Id::Household);
+  if (m_unitest_planning.GetNumDays() == 0U) {
+    BuildPlanning(*pop);
+    // a sweep restored from a checkpoint (see SimCheckpoint) may follow another planning
+    m_unitest_day_in_sweep %= static_cast<unsigned int>(m_unitest_planning.GetNumDays());
+  }
 
-    std::map<std::string, std::map<int, PCRPool>> pools_per_georegion;
-    unsigned int total_pools = 0;
+  //perform the testing, according to the planning: the pools of today in parallel
+  const auto first     = m_unitest_planning.day_begin[m_unitest_day_in_sweep];
+  const auto num_pools = static_cast<long>(m_unitest_planning.day_begin[m_unitest_day_in_sweep + 1U] - first);
+  vector<vector<PublicHealthAgency::Isolation>> isolations(static_cast<size_t>(num_pools));
+#pragma omp parallel for num_threads(static_cast<int>(rnHandlers.size())) schedule(static)
+  for (long i = 0; i < num_pools; i++) {
+    auto&      handler = rnHandlers[static_cast<size_t>(omp_get_thread_num())];
+    const auto pool    = first + static_cast<unsigned int>(i);
+    handler.SetKey(simDay, RnHandler::Purpose::Testing, 0U, pool);
+    TestPool(pool, *pop, handler, simDay, pha, isolations[static_cast<size_t>(i)]);
+  }
+  for (const auto& pool_isolations : isolations) {
+    for (const auto& isolation : pool_isolations) {
+      personEvents.Isolate(simDay, isolation.person, isolation.from, isolation.to);
+    }
+  }
+
+  //move to the next day in the sweep,
+  //if at the end of the sweep: reset
+  ++m_unitest_day_in_sweep;
+  if (m_unitest_day_in_sweep == m_unitest_planning.GetNumDays()) {
+    m_unitest_day_in_sweep = 0; 
+  }
+}
+
+void UniversalTesting::TestPool(unsigned int pool, Population& pop, RnHandler& rnHandler, unsigned short int simDay,
+        const PublicHealthAgency& pha, vector<PublicHealthAgency::Isolation>& isolations) const
+{
+    const auto& planning = m_unitest_planning;
+    auto&       eventLog = pop.RefEventLog();
+    eventLog.Log(EventRecord::UniversalTest(simDay, m_unitest_day_in_sweep));
+
+    const auto detectable = [&](unsigned int member) {
+      const auto& h = pop[planning.members[member]].GetHealth();
+      return h.IsInfected() && h.IsPcrDetectable(simDay, m_unitest_detectable_delay);
+    };
+
+    bool pool_positive_and_detectable = false;
+    vector<unsigned int> tested_households;
+    for (auto hh = planning.pool_begin[pool]; hh < planning.pool_begin[pool + 1U]; ++hh) {
+      bool compliant = rnHandler.Binomial(m_unitest_test_compliance);
+     
+      if (compliant) {
+        tested_households.push_back(hh);
+      
+        for (auto m = planning.household_begin[hh]; m < planning.household_begin[hh + 1U]; ++m) {
+          if (detectable(m))
+            pool_positive_and_detectable = true;
+        }
+      }
+    }
+
+    bool pcr_test_positive = pool_positive_and_detectable && rnHandler.Binomial(1-m_unitest_fnr);
+    if (!pcr_test_positive) {
+      return;
+    }
+    for (const auto hh : tested_households) {
+      if (m_unitest_isolation_strategy == IsolationStrategy::IsolatePool) {
+        bool isolation_compliance = rnHandler.Binomial(m_unitest_isolation_compliance);
+        if (isolation_compliance) {
+          for (auto m = planning.household_begin[hh]; m < planning.household_begin[hh + 1U]; ++m) {
+              Person*      indiv = &pop[planning.members[m]];
+              unsigned int start = simDay + 1 + m_unitest_isolation_delay;
+              isolations.push_back({indiv, start, start + 7});
+              eventLog.Log(EventRecord::UniversalTestIsolate(planning.pool_ids[pool], indiv, m_unitest_isolation_delay, simDay));
+          }
+        }
+      } else {
+        for (auto m = planning.household_begin[hh]; m < planning.household_begin[hh + 1U]; ++m) {
+          if (detectable(m)) {
+            bool pcr_test_positive = rnHandler.Binomial(1-m_unitest_fnr);
+            if (pcr_test_positive)
+              pha.Trace(pop[planning.members[m]], pop, rnHandler, simDay, isolations);
+          }
+        }
+      }
+    }
+}
+
+void UniversalTesting::BuildPlanning(const Population& pop)
+{
+    const auto& households = pop.CRefPoolSys().CRefPools(Id::Household);
+
+    // rows of the allocation, grouped by georegion and pool id (in the order of the file within a pool)
+    struct Row
+    {
+        std::string  georegion;
+        int          pool_id;
+        unsigned int household_id;
+    };
+    vector<Row> rows;
     CSV allocation(m_unitest_pool_allocation);
     size_t georegion_idx = allocation.GetIndexForLabel("province");
     size_t pool_id_idx = allocation.GetIndexForLabel("pool_id");
     size_t household_id_idx = allocation.GetIndexForLabel("household_id");
     for (const auto& row : allocation) {
-        std::string georegion = row.GetValue(georegion_idx);
-        int pool_id = row.GetValue<int>(pool_id_idx);
+        rows.push_back({row.GetValue(georegion_idx), row.GetValue<int>(pool_id_idx),
+                        row.GetValue<unsigned int>(household_id_idx)});
+    }
+    stable_sort(rows.begin(), rows.end(), [](const Row& r1, const Row& r2) {
+        return r1.georegion < r2.georegion || (r1.georegion == r2.georegion && r1.pool_id < r2.pool_id);
+    });
 
-        //if the georegion is not yet in the map, introduce it 
-        if (pools_per_georegion.find(georegion) == pools_per_georegion.end()) {
-            pools_per_georegion[georegion] = std::map<int,PCRPool>();
+    // the pools (and their households) in order of georegion and id
+    Planning staged;
+    staged.pool_begin.push_back(0U);
+    staged.household_begin.push_back(0U);
+    for (size_t r = 0; r < rows.size(); ++r) {
+        if (r == 0 || rows[r].georegion != rows[r - 1].georegion) {
+            staged.georegions.push_back(rows[r].georegion);
         }
-        auto& pools = pools_per_georegion[georegion];
-
-        //if the PCR pool is not yet in the map, introduce it 
-        if (pools.find(pool_id) == pools.end()) {
-            pools[pool_id] = PCRPool();
-            pools[pool_id].SetId(pool_id);
-            pools[pool_id].SetGeoRegion(georegion);
-
-            ++total_pools;
+        if (r > 0 && (rows[r].georegion != rows[r - 1].georegion || rows[r].pool_id != rows[r - 1].pool_id)) {
+            staged.pool_begin.push_back(static_cast<unsigned int>(staged.household_begin.size() - 1U));
         }
-        auto& pool = pools[pool_id];
-
-        int household_id = row.GetValue<int>(household_id_idx);
-		const auto& household = households[household_id].GetPool();
-        pool.AddHousehold(household);
-    } 
-    
-    unsigned int n_days = ceil(total_pools / (float)m_unitest_n_tests_per_day);
-    for (unsigned int day = 0; day < n_days; ++day) {
-        m_unitest_planning.push_back(std::set<PCRPool>());
+        if (staged.pool_ids.size() < staged.pool_begin.size()) {
+            staged.pool_ids.push_back(static_cast<unsigned int>(rows[r].pool_id));
+            staged.pool_georegions.push_back(static_cast<unsigned int>(staged.georegions.size() - 1U));
+        }
+        // in order of id, not of the partitions of the household (which depend on the day of the build)
+        for (const auto p : households[rows[r].household_id].GetPool()) {
+            staged.members.push_back(p->GetId());
+        }
+        sort(staged.members.begin() + staged.household_begin.back(), staged.members.end());
+        staged.household_begin.push_back(static_cast<unsigned int>(staged.members.size()));
+    }
+    staged.pool_begin.push_back(static_cast<unsigned int>(staged.household_begin.size() - 1U));
+    const auto total_pools = static_cast<unsigned int>(staged.pool_ids.size());
+    if (total_pools == 0U) {
+        throw runtime_error("UniversalTesting::BuildPlanning> No pools in allocation: " + m_unitest_pool_allocation);
     }
 
-    unsigned int day = 0;
     //TODO: shuffle regions keys randomly
-    for (const auto& key_val: pools_per_georegion) {
-        const auto& region = key_val.first;
-        const auto& pools = util::MapValuesToVec(pools_per_georegion[region]);
-        //TODO: pools can be shuffled randomly
-        for (const auto& pool: pools) {
-            m_unitest_planning[day].insert(pool);
-            ++day;
-            //when at the end of the planning, reset day
-            if (day == m_unitest_planning.size())
-               day = 0; 
+    //TODO: pools can be shuffled randomly
+    // pool k goes to day k modulo the number of days, within a day the pools are ordered on
+    // their individuals
+    const auto n_days = static_cast<unsigned int>(ceil(total_pools / (float)m_unitest_n_tests_per_day));
+    const auto individuals_less = [&staged](unsigned int p1, unsigned int p2) {
+        const auto b1 = staged.members.begin() + staged.household_begin[staged.pool_begin[p1]];
+        const auto e1 = staged.members.begin() + staged.household_begin[staged.pool_begin[p1 + 1U]];
+        const auto b2 = staged.members.begin() + staged.household_begin[staged.pool_begin[p2]];
+        const auto e2 = staged.members.begin() + staged.household_begin[staged.pool_begin[p2 + 1U]];
+        return lexicographical_compare(b1, e1, b2, e2);
+    };
+    vector<unsigned int> order(total_pools);
+    iota(order.begin(), order.end(), 0U);
+    stable_sort(order.begin(), order.end(), [&](unsigned int p1, unsigned int p2) {
+        return p1 % n_days < p2 % n_days || (p1 % n_days == p2 % n_days && individuals_less(p1, p2));
+    });
+
+    // the planning: the pools in that order
+    auto& planning      = m_unitest_planning;
+    planning            = Planning();
+    planning.georegions = staged.georegions;
+    planning.pool_begin.push_back(0U);
+    planning.household_begin.push_back(0U);
+    planning.day_begin.assign(n_days + 1U, 0U);
+    for (unsigned int p = 0; p < total_pools; ++p) {
+        ++planning.day_begin[p % n_days + 1U];
+    }
+    partial_sum(planning.day_begin.begin(), planning.day_begin.end(), planning.day_begin.begin());
+    for (const auto p : order) {
+        planning.pool_ids.push_back(staged.pool_ids[p]);
+        planning.pool_georegions.push_back(staged.pool_georegions[p]);
+        for (auto hh = staged.pool_begin[p]; hh < staged.pool_begin[p + 1U]; ++hh) {
+            planning.members.insert(planning.members.end(), staged.members.begin() + staged.household_begin[hh],
+                                    staged.members.begin() + staged.household_begin[hh + 1U]);
+            planning.household_begin.push_back(static_cast<unsigned int>(planning.members.size()));
         }
+        planning.pool_begin.push_back(static_cast<unsigned int>(planning.household_begin.size() - 1U));
     }
 
     //write the planning to file
@@ -141,41 +276,34 @@ void UniversalTesting::PerformUniversalTesting(std::shared_ptr<Population> pop,
     of.open(m_unitest_planning_output_fn.c_str());
     of << "day,georegion,id,size" << std::endl;
     for (unsigned int day = 0; day < n_days; ++day) {
-        for (const auto& pool: m_unitest_planning[day]) {
+        for (auto pool = planning.day_begin[day]; pool < planning.day_begin[day + 1U]; ++pool) {
             of << day << "," 
-               << pool.GetGeoRegion() << "," 
-               << pool.GetId() << ","
-               << pool.GetIndividuals().size()
+               << planning.georegions[planning.pool_georegions[pool]] << ","
+               << planning.pool_ids[pool] << ","
+               << planning.GetPoolSize(pool)
                << std::endl;
         }
     }
     of.close();
 
 #ifndef NDEBUG
-    unsigned int enlisted_pop = 0;
     //test: check that the stride population and the population allocated over pools coincide
-    for (unsigned int day = 0; day < n_days; ++day) {
-        for (const auto& pool : m_unitest_planning[day]) {
-            enlisted_pop += pool.GetIndividuals().size();
-        }
-    }
+    unsigned int enlisted_pop = static_cast<unsigned int>(planning.members.size());
     std::cerr << "[UNIVERSAL] Enlisted vs total pop:"
-        << enlisted_pop << " vs " << pop->size() << std::endl;
-    assert(enlisted_pop == pop->size());
+        << enlisted_pop << " vs " << pop.size() << std::endl;
+    assert(enlisted_pop == pop.size());
 
     //test: check that the pools' size does not exceed m_unitest_pool_size
     //test: report the nr of pools that are not completely full 
     //        (i.e., leftover_pools, there should not be many of them)
     int leftover_pools = 0;
     int filled_pools = 0;
-    for (unsigned int day = 0; day < n_days; ++day) {
-        for (const auto& pool : m_unitest_planning[day]) {
-            assert(pool.GetIndividuals().size() <= m_unitest_pool_size);
-            if (pool.GetIndividuals().size() < m_unitest_pool_size) {
-                leftover_pools += 1;
-            } else {
-                filled_pools += 1;
-            }
+    for (unsigned int pool = 0; pool < total_pools; ++pool) {
+        assert(planning.GetPoolSize(pool) <= m_unitest_pool_size);
+        if (planning.GetPoolSize(pool) < m_unitest_pool_size) {
+            leftover_pools += 1;
+        } else {
+            filled_pools += 1;
         }
     }
     std::cerr << "[UNIVERSAL] Leftover pools: " << leftover_pools << std::endl;
@@ -184,77 +312,12 @@ void UniversalTesting::PerformUniversalTesting(std::shared_ptr<Population> pop,
     //test: verify that the number of daily tests is not exceeded
     for (unsigned int day = 0; day < n_days; ++day) {
         std::cerr << "[UNIVERSAL]"
-            << " Daily tests " << m_unitest_planning[day].size()
+            << " Daily tests " << planning.day_begin[day + 1U] - planning.day_begin[day]
             << " on day " << day
             << " vs budget " <<  m_unitest_n_tests_per_day << std::endl;
-        assert(m_unitest_planning[day].size() <= m_unitest_n_tests_per_day);
+        assert(planning.day_begin[day + 1U] - planning.day_begin[day] <= m_unitest_n_tests_per_day);
     }
 #endif 
-  }
-
-  auto& logger = pop->RefEventLogger();
-
-  //perform the testing, according to the planning
-  for (const auto& pool : m_unitest_planning[m_unitest_day_in_sweep]) {
-    logger->info("[UNITEST] {} {}", simDay, m_unitest_day_in_sweep);
-
-    bool pool_positive_and_detectable = false;
-    std::vector<std::vector<Person*>> tested_households;
-    for (const auto& household : pool.GetHouseholds()) {
-      bool compliant = rnHandler.Binomial(m_unitest_test_compliance);
-     
-      if (compliant) {
-        tested_households.push_back(household);
-      
-        for (const Person* indiv : household) {
-          auto h = indiv->GetHealth();
-          if (h.IsInfected() && h.IsPcrDetectable(m_unitest_detectable_delay))
-            pool_positive_and_detectable = true;
-        }
-      }
-    }
-
-    bool pcr_test_positive = pool_positive_and_detectable && rnHandler.Binomial(1-m_unitest_fnr);
-    if (pcr_test_positive) {
-      for (auto& household : tested_households) {
-        if (m_unitest_isolation_strategy == "isolate-pool") {
-          bool isolation_compliance = rnHandler.Binomial(m_unitest_isolation_compliance);
-          if (isolation_compliance) {
-            for (const auto& indiv : household) {
-                unsigned int start = simDay + 1 + m_unitest_isolation_delay;
-                indiv->Isolate(simDay, start, start + 7);
-                logger->info("[UNITEST-ISOLATE] pool_id={} household_id={} indiv_id={} infected?={} isolation_delay={} sim_day={}",
-                //logger->info("[UNITEST-ISOLATE] {} {} {} {} {} {}",
-            	  	                               pool.GetId(),
-                                                   indiv->GetPoolId(Id::Household),
-                                                   indiv->GetId(), 
-                                                   indiv->GetHealth().IsInfected(),
-                                                   m_unitest_isolation_delay,
-                                                   simDay);
-            }
-          }
-        } else if (m_unitest_isolation_strategy == "trace") {
-          for (Person* indiv : household) {
-            auto h = indiv->GetHealth();
-            if (h.IsInfected() && h.IsPcrDetectable(m_unitest_detectable_delay)) {
-              bool pcr_test_positive = rnHandler.Binomial(1-m_unitest_fnr);
-              if (pcr_test_positive)
-                pha.Trace(*indiv, pop, rnHandler, calendar);
-            }
-          }
-        } else {
-          throw std::runtime_error("Invalid unitest_isolation_strategy");
-        }
-      }
-    }
-  }
-
-  //move to the next day in the sweep,
-  //if at the end of the sweep: reset
-  ++m_unitest_day_in_sweep;
-  if (m_unitest_day_in_sweep == m_unitest_planning.size()) {
-    m_unitest_day_in_sweep = 0; 
-  }
 }
 
 } // namespace stride
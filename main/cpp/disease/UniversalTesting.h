@@ -21,7 +21,6 @@
 #pragma once
 
 #include "PublicHealthAgency.h"
-#include "PCRPool.h"
 #include "contact/ContactPool.h"
 #include "util/RnMan.h"
 #include "util/RnHandler.h"
@@ -30,7 +29,7 @@
 
 #include <boost/property_tree/ptree_fwd.hpp>
 
-#include <set>
+#include <string>
 #include <vector>
 
 namespace stride {
@@ -38,7 +37,15 @@ namespace stride {
 class Calendar;
 class Population;
 class Sim;
+class TimingWheel;
 
+/**
+ * Universal testing: the households are allocated to PCR pools (read from file), and the
+ * pools are tested in a sweep over a number of days within the daily test budget. The
+ * planning of the sweep is built once, in flat arrays of indices. The pools of a day are
+ * tested in parallel, each with its own key for the random numbers (see RnHandler::SetKey);
+ * the isolations are collected per pool and scheduled afterwards, in order of the planning.
+ */
 class UniversalTesting 
 {
 public:
@@ -47,8 +54,57 @@ public:
 
 		void Initialize(const boost::property_tree::ptree& config);
 
-       /// Public Health Strategy: perform universal testing
-       void PerformUniversalTesting(std::shared_ptr<Population> pop, util::RnHandler& rnHandler, const std::shared_ptr<Calendar> calendar, PublicHealthAgency& pha);
+       /// Public Health Strategy: perform universal testing, the isolations are scheduled in the given wheel
+       void PerformUniversalTesting(std::shared_ptr<Population> pop, std::vector<util::RnHandler>& rnHandlers,
+               const std::shared_ptr<Calendar> calendar, const PublicHealthAgency& pha, TimingWheel& personEvents);
+
+private:
+        /// What happens to the households of a positive pool.
+        enum class IsolationStrategy
+        {
+                IsolatePool, ///< The (compliant) households are isolated.
+                Trace        ///< The positive individuals are traced (see PublicHealthAgency::Trace).
+        };
+
+        /// The planning of a sweep: the pools of day d are [day_begin[d], day_begin[d + 1]),
+        /// the households of pool p are [pool_begin[p], pool_begin[p + 1]) and the members of
+        /// household h are [household_begin[h], household_begin[h + 1]) in members.
+        struct Planning
+        {
+                Planning()
+                    : day_begin(), pool_ids(), pool_georegions(), pool_begin(), household_begin(), members(),
+                      georegions()
+                {
+                }
+
+                std::vector<unsigned int> day_begin;       ///< First pool of each day (and the end).
+                std::vector<unsigned int> pool_ids;        ///< Id of each pool (in its georegion).
+                std::vector<unsigned int> pool_georegions; ///< Georegion (index) of each pool.
+                std::vector<unsigned int> pool_begin;      ///< First household of each pool (and the end).
+                std::vector<unsigned int> household_begin; ///< First member of each household (and the end).
+                std::vector<unsigned int> members;         ///< Person indices in the population.
+                std::vector<std::string>  georegions;      ///< Names of the georegions.
+
+                /// Number of days in the sweep.
+                std::size_t GetNumDays() const { return day_begin.empty() ? 0U : day_begin.size() - 1U; }
+
+                /// Number of individuals in the pool.
+                unsigned int GetPoolSize(unsigned int pool) const
+                {
+                        return household_begin[pool_begin[pool + 1U]] - household_begin[pool_begin[pool]];
+                }
+        };
+
+private:
+        /// Allocate the households to pools (from file) and spread the pools over the days of a sweep.
+        void BuildPlanning(const Population& pop);
+
+        /// Test the given pool of the planning; the isolations are collected, not scheduled.
+        void TestPool(unsigned int pool, Population& pop, util::RnHandler& rnHandler, unsigned short int simDay,
+                const PublicHealthAgency& pha, std::vector<PublicHealthAgency::Isolation>& isolations) const;
+
+        /// Saves and restores the position in the sweep.
+        friend class SimCheckpoint;
 
 private:
         filesys::path m_unitest_planning_output_fn; ///> Filename to output the planning to
@@ -61,9 +117,9 @@ private:
         double m_unitest_isolation_compliance; ///< Household compliance when isolated (universal testing)
         unsigned int m_unitest_isolation_delay; ///< Delay (in days) after which positive individuals are isolated (universal testing)
         unsigned int m_unitest_detectable_delay; ///< Delay (in days) after which positive individuals become PCR detectable (universal testing)
-        std::string m_unitest_isolation_strategy; ///< Isolation strategy: isolate-pool/trace (universal testing)
+        IsolationStrategy m_unitest_isolation_strategy; ///< Isolation strategy: isolate-pool/trace (universal testing)
         //universal testing planning
-        std::vector<std::set<PCRPool>> m_unitest_planning; ///< Vector with at each element, a set of PCR pools, to be performed at one day
+        Planning m_unitest_planning; ///< The pools to be tested on each day of the sweep
         unsigned int m_unitest_day_in_sweep; ///< The n-th day of the current universal testing sweep
 };
 
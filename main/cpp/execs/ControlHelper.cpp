@@ -135,24 +135,30 @@ void ControlHelper::LogStartup()
         m_stride_logger->trace("Config :\n {}", spretty.str());
 }
 
-void ControlHelper::RegisterViewers(shared_ptr<SimRunner> runner)
+void ControlHelper::RegisterViewers(shared_ptr<SimRunner> runner, bool withCli)
 {
+        // The runner's configuration (that of a scenario when branching, see SimController)
+        const auto& config       = runner->GetConfig();
+        const auto  outputPrefix = config.get<string>("run.output_prefix");
+
         // Command line viewer
-        m_stride_logger->info("Registering CliViewer");
-        const auto cli_v = make_shared<viewers::CliViewer>(runner, m_stride_logger);
-        runner->Register(cli_v, bind(&viewers::CliViewer::Update, cli_v, placeholders::_1));
+        if (withCli) {
+                m_stride_logger->info("Registering CliViewer");
+                const auto cli_v = make_shared<viewers::CliViewer>(runner, m_stride_logger);
+                runner->Register(cli_v, bind(&viewers::CliViewer::Update, cli_v, placeholders::_1));
+        }
 
         // Infection counts viewer
-        if (m_config.get<bool>("run.output_cases", false)) {
+        if (config.get<bool>("run.output_cases", false)) {
                 m_stride_logger->info("Registering InfectedFileViewer");
-                const auto v = make_shared<viewers::InfectedFileViewer>(runner, m_output_prefix);
+                const auto v = make_shared<viewers::InfectedFileViewer>(runner, outputPrefix);
                 runner->Register(v, bind(&viewers::InfectedFileViewer::Update, v, placeholders::_1));
         }
 
         // Summary viewer
-        if (m_config.get<bool>("run.output_summary", false)) {
+        if (config.get<bool>("run.output_summary", false)) {
                 m_stride_logger->info("Registering SummaryFileViewer");
-                const auto v = make_shared<viewers::SummaryFileViewer>(runner, m_output_prefix);
+                const auto v = make_shared<viewers::SummaryFileViewer>(runner, outputPrefix);
                 runner->Register(v, bind(&viewers::SummaryFileViewer::Update, v, placeholders::_1));
         }
 }
@@ -68,8 +68,8 @@ protected:
         /// Logs info on setup for cli environment to stride_logger.
         void LogStartup();
 
-        /// Register the viewers of the SimRunner.
-        void RegisterViewers(std::shared_ptr<SimRunner> runner);
+        /// Register the viewers of the SimRunner (the command line viewer only if asked for).
+        void RegisterViewers(std::shared_ptr<SimRunner> runner, bool withCli = true);
 
         /// Logs info on setup for cli environment to stride_logger.
         void Shutdown();
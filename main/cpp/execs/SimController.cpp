@@ -21,10 +21,24 @@
 #include "SimController.h"
 
 #include "pop/Population.h"
+#include "sim/IndexCaseSim.h"
 #include "sim/Sim.h"
+#include "sim/SimCheckpoint.h"
 #include "sim/SimRunner.h"
+#include "util/CSV.h"
+#include "util/ConfigInfo.h"
+#include "util/FileSys.h"
 
 #include <boost/property_tree/ptree.hpp>
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+#include <stdexcept>
+#include <thread>
+#include <vector>
 
 using namespace std;
 using namespace stride::util;
@@ -33,41 +47,332 @@ using namespace boost::property_tree;
 namespace stride {
 
 SimController::SimController(const ptree& config, const string& name)
-        : ControlHelper(config, name), m_simulator(nullptr) {}
+        : ControlHelper(config, name), m_simulator(nullptr), m_populations(), m_free_populations(),
+          m_populations_mutex(), m_input_cache()
+{
+}
 
-void SimController::Control()
+void SimController::Setup()
 {
-        // -----------------------------------------------------------------------------------------
-        // Prelims.
-        // -----------------------------------------------------------------------------------------
         CheckEnv();
         CheckOutputPrefix();
         InstallLogger();
         LogStartup();
+}
+
+void SimController::Control()
+{
+        // -----------------------------------------------------------------------------------------
+        // Prelims.
+        // -----------------------------------------------------------------------------------------
+        Setup();
+
+        if (m_config.get_child_optional("run.branches")) {
+                ControlBranches();
+        } else {
+                m_simulator = RunSim(m_config);
+        }
+}
 
+void SimController::ControlBranches()
+{
+        // -----------------------------------------------------------------------------------------
+        // The days before the branch day, shared by the branches, up to a checkpoint.
+        // -----------------------------------------------------------------------------------------
+        const auto branchDay      = m_config.get<unsigned int>("run.branch_day");
+        const auto checkpointFile = m_config.get<string>("run.checkpoint_file",
+                                                         FileSys::BuildPath(m_output_prefix, "checkpoint.bin").string());
+        auto       baseConfig     = m_config;
+        baseConfig.get_child("run").erase("branches");
+        baseConfig.get_child("run").erase("checkpoint_day");
+        baseConfig.get_child("run").erase("checkpoint_file");
+
+        auto prefixConfig = baseConfig;
+        prefixConfig.put("run.num_days", branchDay);
+        prefixConfig.put("run.checkpoint_day", branchDay);
+        prefixConfig.put("run.checkpoint_file", checkpointFile);
+        m_stride_logger->info("Simulating the days before branch day {}", branchDay);
+        RunSim(prefixConfig);
+
+        // -----------------------------------------------------------------------------------------
+        // Each branch: the configuration of the run with the overrides of the branch.
+        // -----------------------------------------------------------------------------------------
+        unsigned int i = 0U;
+        for (const auto& branch : m_config.get_child("run.branches")) {
+                if (branch.first != "branch") {
+                        continue;
+                }
+                auto config = baseConfig;
+                config.get_child("run").erase("restore_file");
+                config.put("run.output_prefix", FileSys::BuildPath(m_output_prefix, "branch" + to_string(++i)).string() + "/");
+                for (const auto& item : branch.second) {
+                        config.put_child("run." + item.first, item.second);
+                }
+                config.put("run.restore_file", checkpointFile);
+
+                const auto outputPrefix = config.get<string>("run.output_prefix");
+                if (FileSys::IsDirectoryString(outputPrefix)) {
+                        FileSys::CreateDirectory(outputPrefix);
+                }
+                m_stride_logger->info("Simulating branch {} from day {} into: {}", i, branchDay, outputPrefix);
+                m_simulator = RunSim(config);
+        }
+}
+
+void SimController::ControlBatch()
+{
+        // -----------------------------------------------------------------------------------------
+        // Prelims.
+        // -----------------------------------------------------------------------------------------
+        Setup();
+
+        const auto designFile = m_config.get<string>("run.design_file");
+        ifstream   designStream(designFile);
+        if (!designStream) {
+                throw runtime_error("SimController::ControlBatch> Cannot open design_file: " + designFile);
+        }
+        const CSV   design(designStream);
+        const auto& labels = design.GetLabels();
+        if (m_config.get_child_optional("run.branches") || m_config.get_child_optional("run.branch_day") ||
+            find(labels.begin(), labels.end(), "branch_day") != labels.end()) {
+                throw runtime_error("SimController::ControlBatch> No branches (run.branches, run.branch_day) "
+                                    "with an experiment design.");
+        }
+        m_stride_logger->info("Running {} rows of experiment design: {}", design.size(), designFile);
+
+        // -----------------------------------------------------------------------------------------
+        // Each row: the configuration of the run with the columns of the row.
+        // -----------------------------------------------------------------------------------------
+        auto baseConfig = m_config;
+        baseConfig.get_child("run").erase("design_file");
+        vector<ptree> configs;
+        for (const auto& row : design) {
+                auto          config = baseConfig;
+                ostringstream tag;
+                tag << "exp" << setw(4) << setfill('0') << configs.size() + 1U;
+                config.put("run.output_prefix", FileSys::BuildPath(m_output_prefix, tag.str()).string() + "/");
+                for (const auto& label : labels) {
+                        // an empty (or R's NA) value keeps the parameter of the run
+                        const auto value = row.GetValue<string>(label);
+                        if (!value.empty() && value != "NA") {
+                                config.put("run." + label, value);
+                        }
+                }
+                config.sort();
+
+                const auto outputPrefix = config.get<string>("run.output_prefix");
+                if (FileSys::IsDirectoryString(outputPrefix)) {
+                        FileSys::CreateDirectory(outputPrefix);
+                }
+                configs.emplace_back(std::move(config));
+        }
+        if (configs.empty()) {
+                return;
+        }
+
+        // -----------------------------------------------------------------------------------------
+        // Parallelism: within each simulation (one run at a time, with its num_threads), or over
+        // the runs (several runs at a time, each with a population of its own). Auto runs as many
+        // at a time as the cores allow, provided their populations fit in batch_max_persons, and
+        // divides the cores over them.
+        // -----------------------------------------------------------------------------------------
+        const auto policy = m_config.get<string>("run.batch_parallelism", "Auto");
+        if (policy != "Auto" && policy != "Runs" && policy != "Simulation") {
+                throw runtime_error("SimController::ControlBatch> Invalid batch_parallelism: " + policy);
+        }
+        const auto   numCores   = ConfigInfo::NumberAvailableThreads();
+        const auto   numRuns    = static_cast<unsigned int>(configs.size());
+        unsigned int numWorkers = 1U;
+        unsigned int numThreads = 1U;
+        if (policy == "Runs") {
+                numWorkers = min(numRuns, numCores);
+        } else if (policy == "Auto" && numRuns > 1U && numCores > 1U) {
+                const auto numPersons = max<size_t>(1U, PopulationLease(*this, configs.front()).Get()->size());
+                const auto maxPersons = m_config.get<double>("run.batch_max_persons", 2.0e7);
+                const auto maxWorkers = max(1U, static_cast<unsigned int>(maxPersons / static_cast<double>(numPersons)));
+                numWorkers            = min({numRuns, numCores, maxWorkers});
+                numThreads            = max(1U, numCores / numWorkers);
+        }
+
+        if (numWorkers == 1U) {
+                m_stride_logger->info("Running one row at a time, with the num_threads of the row");
+                for (size_t i = 0U; i < configs.size(); i++) {
+                        m_stride_logger->info("Simulating row {} of the experiment design into: {}", i + 1U,
+                                              configs[i].get<string>("run.output_prefix"));
+                        m_simulator = RunSim(configs[i]);
+                }
+                return;
+        }
+
+        // -----------------------------------------------------------------------------------------
+        // Several rows at a time: each worker takes the next row. The workers are not OpenMP
+        // threads, so that each simulation has OpenMP teams (and thread numbers) of its own. Only
+        // rows with counter-based draws take the threads of the policy: with Stream draws, the
+        // results depend on the number of threads, so those rows keep their num_threads.
+        // -----------------------------------------------------------------------------------------
+        m_stride_logger->info("Running {} rows at a time, with {} thread(s) each for rng_type Counter", numWorkers,
+                              numThreads);
+        for (size_t i = 0U; i < configs.size(); i++) {
+                auto&      config       = configs[i];
+                const auto rowThreads   = config.get<unsigned int>("run.num_threads");
+                const bool counterBased = config.get<string>("run.rng_type", "Stream") == "Counter";
+                if (!counterBased) {
+                        m_stride_logger->info("Row {} keeps its num_threads {} (rng_type Stream)", i + 1U, rowThreads);
+                } else if (rowThreads != numThreads) {
+                        m_stride_logger->info("Row {} runs with {} thread(s) instead of its num_threads {}", i + 1U,
+                                              numThreads, rowThreads);
+                        config.put("run.num_threads", numThreads);
+                }
+        }
+        atomic<size_t>     next{0U};
+        exception_ptr      error;
+        mutex              errorMutex;
+        vector<thread>     workers;
+        for (unsigned int w = 0U; w < numWorkers; w++) {
+                workers.emplace_back([this, &configs, &next, &error, &errorMutex]() {
+                        for (size_t i = next++; i < configs.size(); i = next++) {
+                                try {
+                                        m_stride_logger->info("Simulating row {} of the experiment design into: {}",
+                                                              i + 1U, configs[i].get<string>("run.output_prefix"));
+                                        RunSim(configs[i], false);
+                                        m_stride_logger->info("Done with row {} of the experiment design", i + 1U);
+                                } catch (...) {
+                                        lock_guard<mutex> lock(errorMutex);
+                                        if (!error) {
+                                                error = current_exception();
+                                        }
+                                        next = configs.size();
+                                }
+                        }
+                });
+        }
+        for (auto& worker : workers) {
+                worker.join();
+        }
+        if (error) {
+                rethrow_exception(error);
+        }
+}
+
+namespace {
+
+/// The configuration that PopBuilder reads (other than the number of threads).
+string GetPopulationSource(const ptree& config)
+{
+        return config.get<string>("run.population_file") + "|" + config.get<string>("run.use_install_dirs") + "|" +
+               config.get<string>("run.age_break_school_types", "18");
+}
+
+} // namespace
+
+shared_ptr<Population> SimController::AcquirePopulation(const ptree& config)
+{
+        // Resetting and building happen under the lock, which also guards the lists of populations.
+        lock_guard<mutex> lock(m_populations_mutex);
+        const auto        source = GetPopulationSource(config);
+        auto&             free   = m_free_populations[source];
+        if (!free.empty()) {
+                const auto pop = free.back();
+                free.pop_back();
+                m_stride_logger->info("Resetting the population of: {}", config.get<string>("run.population_file"));
+                pop->Reset(config, m_stride_logger);
+                return pop;
+        }
+        auto&      built = m_populations[source];
+        const auto pop   = built.empty() ? Population::Create(config, m_stride_logger)
+                                         : Population::Create(config, *built.front(), m_stride_logger);
+        built.emplace_back(pop);
+        return pop;
+}
+
+void SimController::ReleasePopulation(const ptree& config, shared_ptr<Population> pop)
+{
+        lock_guard<mutex> lock(m_populations_mutex);
+        m_free_populations[GetPopulationSource(config)].emplace_back(std::move(pop));
+}
+
+shared_ptr<Sim> SimController::RunSim(const ptree& config, bool withCli)
+{
         // -----------------------------------------------------------------------------------------
         // Sim scenario: step 1, build a random number manager.
         // -----------------------------------------------------------------------------------------
-        const RnInfo info{m_config.get<string>("run.rng_seed", "1,2,3,4"), "",
-                          m_config.get<unsigned int>("run.num_threads")};
+        const auto rngType = config.get<string>("run.rng_type", "Stream");
+        if (rngType != "Stream" && rngType != "Counter") {
+                throw runtime_error("SimController::RunSim> Invalid rng_type: " + rngType +
+                                    " (Stream or Counter; the random engine is pcg64 for all draws).");
+        }
+        const RnInfo info{config.get<string>("run.rng_seed", "1,2,3,4"), "",
+                          config.get<unsigned int>("run.num_threads"), rngType == "Counter"};
         RnMan        rnMan{info};
 
         // -----------------------------------------------------------------------------------------
         // Sim scenario: step 2, create a population, as described by the parameter in the config.
         // -----------------------------------------------------------------------------------------
-        auto pop = Population::Create(m_config, m_stride_logger);
+        const PopulationLease lease(*this, config);
+        const auto&           pop = lease.Get();
 
         // -----------------------------------------------------------------------------------------
-        // Sim scenario: step 3, create a simulator, as described by the parameter in the config.
+        // Sim scenario: step 3, create a simulator, as described by the parameter in the config,
+        // and restore it from a checkpoint if requested. Sparse index cases are simulated over the
+        // population as built, without infected seeds (see IndexCaseSim).
         // -----------------------------------------------------------------------------------------
-        m_simulator = Sim::Create(m_config, pop, rnMan);
+        if (config.get<bool>("run.sparse_index_cases", false)) {
+                if (!config.get<bool>("run.track_index_case")) {
+                        throw runtime_error("SimController::RunSim> sparse_index_cases requires track_index_case.");
+                }
+                if (!config.get<string>("run.restore_file", "").empty() ||
+                    !config.get<string>("run.checkpoint_file", "").empty()) {
+                        throw runtime_error("SimController::RunSim> sparse_index_cases without checkpoints.");
+                }
+                const auto numIndexCases = config.get<unsigned int>("run.num_infected_seeds");
+                auto       simConfig     = config;
+                simConfig.put("run.num_infected_seeds", 0U);
+                simConfig.put("run.seeding_rate", 0.0);
+                auto sim = Sim::Create(simConfig, pop, rnMan, &m_input_cache);
+
+                m_stride_logger->info("Simulating {} sparse index cases", numIndexCases);
+                const auto results = IndexCaseSim(sim).Run(numIndexCases);
+                IndexCaseSim::WriteResults(config.get<string>("run.output_prefix"), results);
+                unsigned int numCases = 0U;
+                for (const auto& result : results) {
+                        numCases += result.GetSecondaryCases();
+                }
+                m_stride_logger->info("Mean number of secondary cases: {}",
+                                      static_cast<double>(numCases) / max(1U, numIndexCases));
+
+                pop->RefEventLog().Close();
+                return sim;
+        }
+        auto sim = Sim::Create(config, pop, rnMan, &m_input_cache);
+        const auto restoreFile = config.get<string>("run.restore_file", "");
+        if (!restoreFile.empty()) {
+                m_stride_logger->info("Restoring checkpoint: {}", restoreFile);
+                SimCheckpoint::Restore(restoreFile, *sim);
+        }
 
         // -----------------------------------------------------------------------------------------
-        // Sim scenario: step , build a runner, register viewers and run.
+        // Sim scenario: step 4, build a runner, register viewers and run (saving a checkpoint).
         // -----------------------------------------------------------------------------------------
-        auto runner = make_shared<SimRunner>(m_config, m_simulator);
-        RegisterViewers(runner);
+        auto runner = make_shared<SimRunner>(config, sim);
+        RegisterViewers(runner, withCli);
+        const auto checkpointFile = config.get<string>("run.checkpoint_file", "");
+        if (!checkpointFile.empty()) {
+                const auto checkpointDay = config.get<unsigned int>("run.checkpoint_day");
+                const auto simDay        = sim->GetCalendar()->GetSimulationDay();
+                if (checkpointDay < simDay) {
+                        throw runtime_error("SimController::RunSim> The checkpoint_day precedes the restored day.");
+                }
+                runner->Run(checkpointDay - simDay);
+                m_stride_logger->info("Saving checkpoint of day {}: {}", sim->GetCalendar()->GetSimulationDay(),
+                                      checkpointFile);
+                SimCheckpoint::Save(checkpointFile, *sim);
+        }
         runner->Run();
+
+        // write the remaining (binary) event records, the population can be reset for another run
+        pop->RefEventLog().Close();
+
+        return sim;
 }
 
 } // namespace stride
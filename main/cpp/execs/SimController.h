@@ -21,12 +21,18 @@
 #pragma once
 
 #include "ControlHelper.h"
+#include "sim/SimBuilder.h"
 
-#include <boost/property_tree/ptree_fwd.hpp>
+#include <boost/property_tree/ptree.hpp>
+#include <map>
 #include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
 
 namespace stride {
 
+class Population;
 class Sim;
 
 /**
@@ -40,9 +46,42 @@ class Sim;
  *
  * The SimController execution:
  * \li creates a population (@see Population)
+ * \li creates a simulator and restores a checkpoint (run.restore_file) if any (@see SimCheckpoint)
  * \li creates a simulation runner (@see SimRunner)
  * \li registers the appropriate viewers
- * \li runs the simulation
+ * \li runs the simulation, saving a checkpoint (run.checkpoint_file) on run.checkpoint_day if any
+ *
+ * With run.sparse_index_cases (and run.track_index_case), the run.num_infected_seeds index
+ * cases are simulated as independent replicates over the population, visiting only their own
+ * contact pools, instead of time stepping the simulator (@see IndexCaseSim). The secondary cases
+ * of each index case go to index_cases.csv in the output prefix.
+ *
+ * With scenarios to branch (run.branches), the days before run.branch_day are simulated once
+ * with the configuration of the run, writing a checkpoint (run.checkpoint_file, by default in the
+ * output prefix) and the outputs up to the branch day. Each branch then restores the checkpoint
+ * into a simulator built with the configuration of the run, overridden by the elements of the
+ * branch (e.g. holidays_file or tracing parameters), and simulates the remaining days. Its
+ * outputs start at the branch day and go to the branch's output_prefix (by default branch<i>
+ * in the output prefix of the run).
+ *
+ * In batch mode (ControlBatch), the rows of an experiment design (run.design_file, a csv
+ * file) are run, each with the configuration of the run overridden by the columns of the row
+ * (named after the run parameters without "run."). Each row writes to its own output_prefix
+ * (by default exp<row> in the output prefix of the run). With run.batch_parallelism Simulation,
+ * the rows run one after the other with their num_threads; with Runs, as many rows run at a
+ * time as there are cores, each with one thread. With Auto (the default), as many rows run at
+ * a time as there are cores and as fit in run.batch_max_persons (default 2e7) persons, with
+ * the cores divided over them; a large population thus runs one row at a time. When rows run
+ * at the same time, only rows with rng_type Counter (whose results do not depend on the number
+ * of threads) take the threads of Runs or Auto; rows with rng_type Stream keep their num_threads.
+ * Each row that runs with other threads than its num_threads is logged. Branches (run.branches,
+ * run.branch_day) are not combined with an experiment design.
+ *
+ * The populations, the contact and disease configuration files and the calendars are read
+ * once per controller. A population that was built for an earlier run (of the same population
+ * file) is reset to its state as built (@see Population::Reset) rather than read again; runs
+ * at the same time share its topology (ages and pools, @see PopTopology) and each have a state
+ * of their own (persons and pool order), so that an extra run costs only that state.
  */
 class SimController : protected ControlHelper
 {
@@ -53,11 +92,66 @@ public:
         /// Control the execution of the simulation.
         void Control();
 
+        /// Control the execution of the simulations of the rows of the experiment design.
+        void ControlBatch();
+
         /// Reference the simulator (method used mostly in tests).
         std::shared_ptr<Sim> GetSim() const { return m_simulator; };
 
 private:
-        std::shared_ptr<Sim> m_simulator;
+        /// Check the environment and output prefix, install the logger and log the startup.
+        void Setup();
+
+        /// Simulate the days before the branch day once and each of the branches from there.
+        void ControlBranches();
+
+        /// A population for the configuration that no other run uses: one that is no longer in use,
+        /// reset; otherwise one that shares the topology of one built earlier (or built, the first time).
+        std::shared_ptr<Population> AcquirePopulation(const boost::property_tree::ptree& config);
+
+        /// The run with the population (for the configuration) is done.
+        void ReleasePopulation(const boost::property_tree::ptree& config, std::shared_ptr<Population> pop);
+
+        /// A population acquired for a run, released when the run is done, also when it fails.
+        class PopulationLease
+        {
+        public:
+                ///
+                PopulationLease(SimController& controller, const boost::property_tree::ptree& config)
+                    : m_controller(controller), m_config(config), m_pop(controller.AcquirePopulation(config))
+                {
+                }
+
+                ///
+                ~PopulationLease() { m_controller.ReleasePopulation(m_config, m_pop); }
+
+                ///
+                PopulationLease(const PopulationLease&) = delete;
+
+                ///
+                PopulationLease& operator=(const PopulationLease&) = delete;
+
+                /// The population.
+                const std::shared_ptr<Population>& Get() const { return m_pop; }
+
+        private:
+                SimController&                      m_controller;
+                const boost::property_tree::ptree&  m_config;
+                std::shared_ptr<Population>         m_pop;
+        };
+
+        /// Build and run the simulator for the configuration (restoring and saving checkpoints),
+        /// with or without the command line viewer.
+        std::shared_ptr<Sim> RunSim(const boost::property_tree::ptree& config, bool withCli = true);
+
+private:
+        using PopulationsBySource = std::map<std::string, std::vector<std::shared_ptr<Population>>>;
+
+        std::shared_ptr<Sim> m_simulator;          ///< The simulator of the last run.
+        PopulationsBySource  m_populations;        ///< Populations built, by source.
+        PopulationsBySource  m_free_populations;   ///< Populations not in use, by source.
+        std::mutex           m_populations_mutex;  ///< Guards the populations.
+        SimInputCache        m_input_cache;        ///< Inputs of the simulators.
 };
 
 } // namespace stride
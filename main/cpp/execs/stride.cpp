@@ -19,6 +19,7 @@
  */
 
 #include "SimController.h"
+#include "pop/EventLog.h"
 #include "util/FileSys.h"
 #include "util/RunConfigManager.h"
 #include "util/StringUtils.h"
@@ -26,6 +27,7 @@
 
 #include <boost/property_tree/ptree.hpp>
 #include <tclap/CmdLine.h>
+#include <fstream>
 #include <iostream>
 #include <regex>
 #include <string>
@@ -64,10 +66,14 @@ int main(int argc, char** argv)
                             "\nDefaults to -c file=run_default.xml";
                 ValueArg<string> configArg("c", "config", sc, false, "run_default.xml", "CONFIGURATION", cmd);
 
-                vector<string>           execs{"clean", "sim"};
+                vector<string>           execs{"batch", "clean", "decode", "sim"};
                 ValuesConstraint<string> vc(execs);
                 string                   se = "Execute the corresponding function:"
+                            "  \n\t batch:  runs the simulator for each row of the experiment design "
+                            "(design_file), reading each population once."
                             "  \n\t clean:  cleans configuration and writes it to a new file."
+                            "  \n\t decode: appends the binary event log of the output_prefix to its text event log,"
+                            " after the (text) setup and survey lines."
                             "  \n\t sim:    runs the simulator and is the default."
                             "\nDefaults to --exec sim.";
                 ValueArg<string> execArg("e", "exec", se, false, "sim", &vc, cmd);
@@ -95,6 +101,18 @@ int main(int argc, char** argv)
                         configPt.put("run." + v[0], v[1]);
                 }
 
+                // -----------------------------------------------------------------------------------------
+                // decode binary event log (event_log_format=Binary) into the text event log
+                // -----------------------------------------------------------------------------------------
+                if (execArg.getValue() == "decode") {
+                        const auto prefix  = configPt.get<string>("run.output_prefix");
+                        const auto binPath = FileSys::BuildPath(prefix, "event_log.bin");
+                        const auto txtPath = FileSys::BuildPath(prefix, "event_log.txt");
+                        ofstream   os(txtPath.string(), ios::app);
+                        EventLog::Decode(binPath.string(), os);
+                        return exitStatus;
+                }
+
                 // -----------------------------------------------------------------------------------------
                 // config and run simulation in cli
                 // -----------------------------------------------------------------------------------------
@@ -108,7 +126,11 @@ int main(int argc, char** argv)
 				configPt.sort();
 
 				// activate the controller
-				SimController(configPt).Control();
+				if (execArg.getValue() == "batch") {
+						SimController(configPt).ControlBatch();
+				} else {
+						SimController(configPt).Control();
+				}
 
 
 
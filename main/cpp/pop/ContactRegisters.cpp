@@ -0,0 +1,139 @@
+/*
+ *  This is free software: you can redistribute it and/or modify it
+ *  under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  any later version.
+ *  The software is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *  You should have received a copy of the GNU General Public License
+ *  along with the software. If not, see <http://www.gnu.org/licenses/>.
+ *
+ *  Copyright 2020, Willem L, Kuylen E, Broeckhove J
+ */
+
+/**
+ * @file
+ * Implementation of the ContactRegisters class.
+ */
+
+#include "ContactRegisters.h"
+
+#include <algorithm>
+#include <utility>
+
+namespace stride {
+
+using namespace std;
+
+constexpr ContactRegisters::Entry ContactRegisters::EMPTY;
+constexpr unsigned int            ContactRegisters::MIN_LOG2_CAPACITY;
+
+ContactRegisters::ContactRegisters(unsigned int lookbackDays)
+    : m_tables(), m_free_handles(), m_pool(), m_lookback_days(lookbackDays)
+{
+}
+
+void ContactRegisters::Register(Person& indexCase, const Person& contact, unsigned short int simDay)
+{
+        if (!indexCase.IsTracingIndexCase() || !indexCase.GetHealth().IsInfected()) {
+                return;
+        }
+        auto& table = m_tables[RefHandle(indexCase) - 1U];
+
+        // keep the table at most half full
+        if (2U * (table.size + 1U) > table.slots.size()) {
+                unsigned int log2Capacity = MIN_LOG2_CAPACITY;
+                while ((size_t(1U) << log2Capacity) <= table.slots.size()) {
+                        ++log2Capacity;
+                }
+                auto slots = Acquire(log2Capacity);
+                for (const auto e : table.slots) {
+                        if (e != EMPTY) {
+                                Insert(slots, static_cast<uint32_t>(e & 0xFFFFFFFFU),
+                                       static_cast<unsigned short int>(e >> 32U));
+                        }
+                }
+                swap(slots, table.slots);
+                Recycle(std::move(slots));
+        }
+        if (Insert(table.slots, contact.GetId(), simDay)) {
+                ++table.size;
+        }
+}
+
+void ContactRegisters::Release(Person& p)
+{
+        const auto handle = p.GetContactRegister();
+        if (handle == 0U) {
+                return;
+        }
+        auto& table = m_tables[handle - 1U];
+        Recycle(std::move(table.slots));
+        table.slots.clear();
+        table.size = 0U;
+        m_free_handles.emplace_back(handle);
+        p.SetContactRegister(0U);
+}
+
+vector<ContactRegisters::Entry> ContactRegisters::Acquire(unsigned int log2Capacity)
+{
+        if (log2Capacity < m_pool.size() && !m_pool[log2Capacity].empty()) {
+                auto slots = std::move(m_pool[log2Capacity].back());
+                m_pool[log2Capacity].pop_back();
+                return slots;
+        }
+        return vector<Entry>(size_t(1U) << log2Capacity, EMPTY);
+}
+
+void ContactRegisters::Recycle(vector<Entry>&& slots)
+{
+        if (slots.empty()) {
+                return;
+        }
+        unsigned int log2Capacity = 0U;
+        while ((size_t(1U) << log2Capacity) < slots.size()) {
+                ++log2Capacity;
+        }
+        if (m_pool.size() <= log2Capacity) {
+                m_pool.resize(log2Capacity + 1U);
+        }
+        fill(slots.begin(), slots.end(), EMPTY);
+        m_pool[log2Capacity].emplace_back(std::move(slots));
+}
+
+bool ContactRegisters::Insert(vector<Entry>& slots, uint32_t id, unsigned short int day)
+{
+        // multiplicative hashing on the id (high bits folded in), linear probing
+        const auto     mask = slots.size() - 1U;
+        const uint32_t hash = id * 0x9E3779B9U;
+        auto           i    = static_cast<size_t>(hash ^ (hash >> 16U)) & mask;
+        while (slots[i] != EMPTY) {
+                if (static_cast<uint32_t>(slots[i] & 0xFFFFFFFFU) == id) {
+                        slots[i] = (static_cast<Entry>(day) << 32U) | id;
+                        return false;
+                }
+                i = (i + 1U) & mask;
+        }
+        slots[i] = (static_cast<Entry>(day) << 32U) | id;
+        return true;
+}
+
+unsigned int ContactRegisters::RefHandle(Person& p)
+{
+        auto handle = p.GetContactRegister();
+        if (handle == 0U) {
+                if (m_free_handles.empty()) {
+                        m_tables.emplace_back();
+                        handle = static_cast<unsigned int>(m_tables.size());
+                } else {
+                        handle = m_free_handles.back();
+                        m_free_handles.pop_back();
+                }
+                p.SetContactRegister(handle);
+        }
+        return handle;
+}
+
+} // namespace stride
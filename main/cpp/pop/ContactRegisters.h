@@ -0,0 +1,123 @@
+/*
+ *  This is free software: you can redistribute it and/or modify it
+ *  under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  any later version.
+ *  The software is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *  You should have received a copy of the GNU General Public License
+ *  along with the software. If not, see <http://www.gnu.org/licenses/>.
+ *
+ *  Copyright 2020, Willem L, Kuylen E, Broeckhove J
+ */
+
+/**
+ * @file
+ * Header for the ContactRegisters class.
+ */
+
+#pragma once
+
+#include "pop/Person.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace stride {
+
+/**
+ * Contact registers of the tracing index cases. The register of a person is a set of the
+ * ids of its contacts (open addressing with linear probing, at most half full), each with
+ * the day of the last contact. A repeated contact only updates that day, so a register
+ * holds each contact once. The slot tables are taken from a pool that keeps the released
+ * tables per capacity for reuse; a register is released when its person recovers (see
+ * Population::UpdateHealth), so the memory is bounded by the registers of the infected
+ * tracing index cases. Registering and releasing are not thread-safe, visiting is.
+ */
+class ContactRegisters
+{
+public:
+        /// Registers that keep the contacts of the given number of days before tracing (0: all).
+        explicit ContactRegisters(unsigned int lookbackDays = 0U);
+
+        /// Set the number of days before tracing in which the contacts count (0: all).
+        void SetLookbackDays(unsigned int lookbackDays) { m_lookback_days = lookbackDays; }
+
+        /// Register the contact on the given day, if the index case is an infected tracing index case.
+        void Register(Person& indexCase, const Person& contact, unsigned short int simDay);
+
+        /// Release the register of the person (if any) to the pool.
+        void Release(Person& p);
+
+        /// Call f with the id of each contact in the register of the person within the lookback
+        /// window of the given day (in the order of the table); return the number of contacts.
+        template <typename F>
+        unsigned int ForEach(const Person& p, unsigned short int simDay, F f) const;
+
+        /// Number of registers in use.
+        std::size_t GetNumRegisters() const { return m_tables.size() - m_free_handles.size(); }
+
+private:
+        /// Id of the contact in the low word, day of the last contact in the high word.
+        using Entry = std::uint64_t;
+
+        /// Open addressing table of one register.
+        struct Table
+        {
+                Table() : slots(), size(0U) {}
+
+                std::vector<Entry> slots; ///< Power of two number of slots.
+                unsigned int       size;  ///< Number of contacts.
+        };
+
+        /// Empty slot (no person has this id).
+        static constexpr Entry EMPTY = ~Entry(0U);
+
+        /// Initial number of slots.
+        static constexpr unsigned int MIN_LOG2_CAPACITY = 4U;
+
+private:
+        /// Slots of the given capacity (log2), from the pool if possible.
+        std::vector<Entry> Acquire(unsigned int log2Capacity);
+
+        /// Return the slots to the pool.
+        void Recycle(std::vector<Entry>&& slots);
+
+        /// Insert the id or update its day; true if it was inserted.
+        static bool Insert(std::vector<Entry>& slots, std::uint32_t id, unsigned short int day);
+
+        /// Handle of the person's register, after allocating one if need be.
+        unsigned int RefHandle(Person& p);
+
+        /// Saves and restores the registers.
+        friend class SimCheckpoint;
+
+private:
+        std::vector<Table>                           m_tables;        ///< Registers, by handle - 1.
+        std::vector<unsigned int>                    m_free_handles;  ///< Handles of released registers.
+        std::vector<std::vector<std::vector<Entry>>> m_pool;          ///< Released slots per capacity (log2).
+        unsigned int                                 m_lookback_days; ///< Days before tracing that count.
+};
+
+template <typename F>
+unsigned int ContactRegisters::ForEach(const Person& p, unsigned short int simDay, F f) const
+{
+        const auto handle = p.GetContactRegister();
+        if (handle == 0U) {
+                return 0U;
+        }
+        unsigned int count = 0U;
+        for (const auto e : m_tables[handle - 1U].slots) {
+                const auto day = static_cast<unsigned int>(e >> 32U);
+                if (e != EMPTY && (m_lookback_days == 0U || simDay <= day + m_lookback_days)) {
+                        f(static_cast<unsigned int>(e & 0xFFFFFFFFU));
+                        ++count;
+                }
+        }
+        return count;
+}
+
+} // namespace stride
@@ -0,0 +1,201 @@
+/*
+ *  This is free software: you can redistribute it and/or modify it
+ *  under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  any later version.
+ *  The software is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *  You should have received a copy of the GNU General Public License
+ *  along with the software. If not, see <http://www.gnu.org/licenses/>.
+ *
+ *  Copyright 2020, Willem L, Kuylen E, Broeckhove J
+ */
+
+/**
+ * @file
+ * Implementation of the EventLog class.
+ */
+
+#include "EventLog.h"
+
+#include <array>
+#include <omp.h>
+#include <ostream>
+#include <stdexcept>
+
+namespace stride {
+
+using namespace std;
+
+namespace {
+
+/// Number of records in a block.
+constexpr size_t BLOCK_SIZE = 4096U;
+
+/// Number of blocks per thread (one being filled, the others being written or free).
+constexpr size_t BLOCKS_PER_THREAD = 4U;
+
+/// Header of the binary file: magic, format version and record width.
+constexpr array<char, 8> MAGIC{{'S', 'T', 'R', 'I', 'D', 'E', 'E', 'V'}};
+constexpr uint32_t       VERSION = 2U;
+
+/// New block with room for BLOCK_SIZE records.
+unique_ptr<vector<EventRecord>> NewBlock()
+{
+        auto block = make_unique<vector<EventRecord>>();
+        block->reserve(BLOCK_SIZE);
+        return block;
+}
+
+} // namespace
+
+EventLog::EventLog()
+    : m_text(), m_file(nullptr), m_rings(1), m_full(), m_free(), m_mutex(), m_changed(), m_stop(false), m_writer()
+{
+}
+
+EventLog::~EventLog()
+{
+        try {
+                Close();
+        } catch (...) {
+                // nothing to be done at this point
+        }
+}
+
+void EventLog::OpenText(shared_ptr<spdlog::logger> logger) { m_text = std::move(logger); }
+
+void EventLog::OpenBinary(const string& fileName)
+{
+        m_file = fopen(fileName.c_str(), "wb");
+        if (m_file == nullptr) {
+                throw runtime_error("EventLog::OpenBinary> Cannot open file: " + fileName);
+        }
+        const uint32_t width = sizeof(EventRecord);
+        fwrite(MAGIC.data(), sizeof(char), MAGIC.size(), m_file);
+        fwrite(&VERSION, sizeof(VERSION), 1U, m_file);
+        fwrite(&width, sizeof(width), 1U, m_file);
+
+        SetNumThreads(static_cast<unsigned int>(m_rings.size()));
+        m_stop   = false;
+        m_writer = thread(&EventLog::Write, this);
+}
+
+void EventLog::SetNumThreads(unsigned int numThreads)
+{
+        m_rings.resize(numThreads);
+        if (m_file != nullptr) {
+                lock_guard<mutex> lock(m_mutex);
+                for (auto& ring : m_rings) {
+                        if (!ring.current) {
+                                ring.current = NewBlock();
+                                for (size_t i = 1U; i < BLOCKS_PER_THREAD; i++) {
+                                        m_free.emplace_back(NewBlock());
+                                }
+                        }
+                }
+        }
+}
+
+void EventLog::Log(const EventRecord& record)
+{
+        if (m_file != nullptr) {
+                auto& ring = m_rings[static_cast<size_t>(omp_get_thread_num())];
+                ring.current->emplace_back(record);
+                if (ring.current->size() == BLOCK_SIZE) {
+                        Submit(ring);
+                }
+        } else if (m_text) {
+                m_text->info(record.ToString());
+        }
+}
+
+void EventLog::Flush()
+{
+        if (m_file != nullptr) {
+                for (auto& ring : m_rings) {
+                        if (!ring.current->empty()) {
+                                Submit(ring);
+                        }
+                }
+        }
+        if (m_text) {
+                m_text->flush();
+        }
+}
+
+void EventLog::Close()
+{
+        Flush();
+        m_text.reset();
+        if (m_file == nullptr) {
+                return;
+        }
+        {
+                lock_guard<mutex> lock(m_mutex);
+                m_stop = true;
+        }
+        m_changed.notify_all();
+        m_writer.join();
+        fclose(m_file);
+        m_file = nullptr;
+}
+
+void EventLog::Submit(Ring& ring)
+{
+        unique_lock<mutex> lock(m_mutex);
+        m_full.emplace_back(std::move(ring.current));
+        m_changed.notify_all();
+        m_changed.wait(lock, [this]() { return !m_free.empty(); });
+        ring.current = std::move(m_free.back());
+        m_free.pop_back();
+}
+
+void EventLog::Write()
+{
+        unique_lock<mutex> lock(m_mutex);
+        while (true) {
+                m_changed.wait(lock, [this]() { return m_stop || !m_full.empty(); });
+                if (m_full.empty()) {
+                        break;
+                }
+                auto block = std::move(m_full.front());
+                m_full.pop_front();
+
+                lock.unlock();
+                fwrite(block->data(), sizeof(EventRecord), block->size(), m_file);
+                block->clear();
+                lock.lock();
+
+                m_free.emplace_back(std::move(block));
+                m_changed.notify_all();
+        }
+}
+
+void EventLog::Decode(const string& fileName, ostream& os)
+{
+        unique_ptr<FILE, int (*)(FILE*)> file(fopen(fileName.c_str(), "rb"), &fclose);
+        if (!file) {
+                throw runtime_error("EventLog::Decode> Cannot open file: " + fileName);
+        }
+        array<char, 8> magic{};
+        uint32_t       version = 0U;
+        uint32_t       width   = 0U;
+        if (fread(magic.data(), sizeof(char), magic.size(), file.get()) != magic.size() || magic != MAGIC ||
+            fread(&version, sizeof(version), 1U, file.get()) != 1U || version != VERSION ||
+            fread(&width, sizeof(width), 1U, file.get()) != 1U || width != sizeof(EventRecord)) {
+                throw runtime_error("EventLog::Decode> Not a binary event log (of this version): " + fileName);
+        }
+
+        vector<EventRecord> block(BLOCK_SIZE);
+        size_t              count = 0U;
+        while ((count = fread(block.data(), sizeof(EventRecord), BLOCK_SIZE, file.get())) > 0U) {
+                for (size_t i = 0U; i < count; i++) {
+                        os << block[i].ToString() << '\n';
+                }
+        }
+}
+
+} // namespace stride
@@ -0,0 +1,121 @@
+/*
+ *  This is free software: you can redistribute it and/or modify it
+ *  under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  any later version.
+ *  The software is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *  You should have received a copy of the GNU General Public License
+ *  along with the software. If not, see <http://www.gnu.org/licenses/>.
+ *
+ *  Copyright 2020, Willem L, Kuylen E, Broeckhove J
+ */
+
+/**
+ * @file
+ * Header for the EventLog class.
+ */
+
+#pragma once
+
+#include "pop/EventRecord.h"
+
+#include <condition_variable>
+#include <cstdio>
+#include <deque>
+#include <iosfwd>
+#include <memory>
+#include <mutex>
+#include <spdlog/spdlog.h>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace stride {
+
+/**
+ * Event log for the contact, transmission, tracing and testing events of the simulation.
+ * In text mode, each record is formatted as a line of the text event log. In binary mode,
+ * each (OpenMP) thread appends the fixed-width records to its own block of records,
+ * without locking or formatting. Full blocks are handed to a background thread that writes
+ * them to file and returns them for reuse; each thread has a fixed ring of blocks, so a
+ * thread only waits when the writer falls behind. The binary file is decoded to the
+ * text log with Decode.
+ * The blocks are handed over at the end of each day (see Flush), so the binary file is in
+ * order of simulation day; within a day, the records of the threads interleave per block, as
+ * the lines of the threads interleave in the text log.
+ * The per-person lines of the setup and the survey (PART, VACC, NCOM) are always written as text.
+ */
+class EventLog
+{
+public:
+        /// Log that drops all records.
+        EventLog();
+
+        /// Writes the remaining records and closes the binary file.
+        ~EventLog();
+
+        /// No copying.
+        EventLog(const EventLog&) = delete;
+
+        /// No copy assignment.
+        EventLog& operator=(const EventLog&) = delete;
+
+        /// Format the records as lines of the given (text) logger.
+        void OpenText(std::shared_ptr<spdlog::logger> logger);
+
+        /// Write the records in binary form to the given file.
+        void OpenBinary(const std::string& fileName);
+
+        /// Set up one block ring for each of the given number of (OpenMP) threads.
+        void SetNumThreads(unsigned int numThreads);
+
+        /// Is there a text or binary output?
+        bool IsOpen() const { return m_text || m_file; }
+
+        /// Log the record (in the ring of the calling thread for binary output).
+        void Log(const EventRecord& record);
+
+        /// Hand over the partial blocks to the writer, flush the text logger. Not thread-safe.
+        void Flush();
+
+        /// Write the remaining records and close the output (text or binary). Not thread-safe.
+        void Close();
+
+        /// Decode the binary file to lines of the text log, in the order of the file (simulation day).
+        static void Decode(const std::string& fileName, std::ostream& os);
+
+private:
+        /// Records that are written to file in one go.
+        using Block = std::vector<EventRecord>;
+
+        /// Block of a thread that is being filled, padded to avoid false sharing.
+        struct alignas(64) Ring
+        {
+                Ring() : current() {}
+
+                std::unique_ptr<Block> current; ///< Block being filled.
+        };
+
+private:
+        /// Hand over the current block of the ring and take a free one.
+        void Submit(Ring& ring);
+
+        /// Write the handed over blocks, until closed.
+        void Write();
+
+private:
+        std::shared_ptr<spdlog::logger>     m_text;    ///< Logger for text output.
+        std::FILE*                          m_file;    ///< File for binary output.
+        std::vector<Ring>                   m_rings;   ///< Block being filled, per thread.
+        std::deque<std::unique_ptr<Block>>  m_full;    ///< Blocks waiting for the writer.
+        std::vector<std::unique_ptr<Block>> m_free;    ///< Blocks to be filled.
+        std::mutex                          m_mutex;   ///< Guards the full and free blocks and the stop flag.
+        std::condition_variable             m_changed; ///< Signals a change in full or free blocks.
+        bool                                m_stop;    ///< Writer stops when all full blocks are written.
+        std::thread                         m_writer;  ///< Background writer.
+};
+
+} // namespace stride
@@ -0,0 +1,231 @@
+/*
+ *  This is free software: you can redistribute it and/or modify it
+ *  under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  any later version.
+ *  The software is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *  You should have received a copy of the GNU General Public License
+ *  along with the software. If not, see <http://www.gnu.org/licenses/>.
+ *
+ *  Copyright 2020, Willem L, Kuylen E, Broeckhove J
+ */
+
+/**
+ * @file
+ * Implementation of the EventRecord class.
+ */
+
+#include "EventRecord.h"
+
+#include "pop/Person.h"
+
+#include <spdlog/fmt/fmt.h>
+#include <stdexcept>
+
+namespace stride {
+
+using namespace std;
+using namespace stride::ContactType;
+
+namespace {
+
+/// Bits in EventRecord::flags.
+constexpr uint8_t FIRST  = 1U;
+constexpr uint8_t SECOND = 2U;
+
+inline uint8_t Flags(bool first, bool second)
+{
+        return static_cast<uint8_t>((first ? FIRST : 0U) | (second ? SECOND : 0U));
+}
+
+inline bool IsSet(const EventRecord& r, uint8_t bit) { return (r.flags & bit) != 0U; }
+
+/// Text of the setting of a traced contact.
+string ToString(EventRecord::TracePlace place)
+{
+        switch (place) {
+        case EventRecord::TracePlace::School: return "School";
+        case EventRecord::TracePlace::Household: return ContactType::ToString(Id::Household);
+        case EventRecord::TracePlace::Community: return "Community";
+        case EventRecord::TracePlace::Workplace: return "Workplace";
+        case EventRecord::TracePlace::Index: return "Index";
+        }
+        throw runtime_error("EventRecord::ToString> Invalid trace place.");
+}
+
+} // namespace
+
+EventRecord EventRecord::Contact(const Person* p1, const Person* p2, ContactType::Id type, unsigned short int simDay,
+                                 double cProb, double tProb)
+{
+        EventRecord r{};
+        r.tag       = Tag::Contact;
+        r.type      = static_cast<uint8_t>(type);
+        r.flags     = Flags(p1->GetHealth().IsSymptomatic(), p2->GetHealth().IsSymptomatic());
+        r.sim_day   = simDay;
+        r.ids[0]    = p1->GetId();
+        r.ages[0]   = p1->GetAge();
+        r.ages[1]   = p2->GetAge();
+        r.values[0] = cProb;
+        r.values[1] = tProb;
+        return r;
+}
+
+EventRecord EventRecord::Transmission(const Person* p1, const Person* p2, ContactType::Id type,
+                                      unsigned short int simDay, unsigned int idIndexCase, double relInfectiousness)
+{
+        const auto& h2 = p2->GetHealth();
+        EventRecord r{};
+        r.tag       = Tag::Transmission;
+        r.type      = static_cast<uint8_t>(type);
+        r.flags     = Flags(p1->GetHealth().IsSymptomatic(), false);
+        r.sim_day   = simDay;
+        r.days[0]   = h2.GetStartInfectiousness();
+        r.days[1]   = h2.GetEndInfectiousness();
+        r.days[2]   = h2.GetStartSymptomatic();
+        r.days[3]   = h2.GetEndSymptomatic();
+        r.ids[0]    = p1->GetId();
+        r.ids[1]    = p2->GetId();
+        r.ids[2]    = idIndexCase;
+        r.ages[0]   = p1->GetAge();
+        r.ages[1]   = p2->GetAge();
+        r.values[0] = relInfectiousness;
+        r.values[1] = h2.GetRelativeSusceptibility();
+        return r;
+}
+
+EventRecord EventRecord::TransmissionIncidence(const Person* p2, unsigned short int simDay)
+{
+        const auto& h2 = p2->GetHealth();
+        EventRecord r{};
+        r.tag     = Tag::TransmissionIncidence;
+        r.sim_day = simDay;
+        r.days[0] = h2.GetStartInfectiousness();
+        r.days[2] = h2.GetStartSymptomatic();
+        r.days[3] = h2.GetEndSymptomatic();
+        r.ages[1] = p2->GetAge();
+        return r;
+}
+
+EventRecord EventRecord::Trace(const Person* contact, TracePlace place, const Person* indexCase,
+                               unsigned short int simDay)
+{
+        EventRecord r{};
+        r.tag     = Tag::Trace;
+        r.type    = static_cast<uint8_t>(place);
+        r.flags   = Flags(contact->GetHealth().IsInfected(), contact->GetHealth().IsSymptomatic());
+        r.sim_day = simDay;
+        r.ids[0]  = contact->GetId();
+        r.ids[1]  = indexCase->GetId();
+        r.ages[0] = contact->GetAge();
+        r.ages[1] = indexCase->GetAge();
+        return r;
+}
+
+EventRecord EventRecord::TraceIndex(const Person* indexCase, unsigned short int simDay, unsigned int numRegistered,
+                                    unsigned int numTested)
+{
+        EventRecord r = Trace(indexCase, TracePlace::Index, indexCase, simDay);
+        r.ids[2]      = numRegistered;
+        r.ids[3]      = numTested;
+        return r;
+}
+
+EventRecord EventRecord::UniversalTest(unsigned short int simDay, unsigned int dayInSweep)
+{
+        EventRecord r{};
+        r.tag     = Tag::UniversalTest;
+        r.sim_day = simDay;
+        r.ids[0]  = dayInSweep;
+        return r;
+}
+
+EventRecord EventRecord::UniversalTestIsolate(unsigned int poolId, const Person* p, unsigned int isolationDelay,
+                                              unsigned short int simDay)
+{
+        EventRecord r{};
+        r.tag     = Tag::UniversalTestIsolate;
+        r.flags   = Flags(p->GetHealth().IsInfected(), false);
+        r.sim_day = simDay;
+        r.ids[0]  = poolId;
+        r.ids[1]  = p->GetPoolId(Id::Household);
+        r.ids[2]  = p->GetId();
+        r.ids[3]  = isolationDelay;
+        return r;
+}
+
+EventRecord EventRecord::Primary(const Person* p, unsigned short int simDay)
+{
+        const auto& h = p->GetHealth();
+        EventRecord r{};
+        r.tag       = Tag::Primary;
+        r.sim_day   = simDay;
+        r.days[0]   = h.GetStartInfectiousness();
+        r.days[1]   = h.GetEndInfectiousness();
+        r.days[2]   = h.GetStartSymptomatic();
+        r.days[3]   = h.GetEndSymptomatic();
+        r.ids[0]    = p->GetId();
+        r.ages[0]   = p->GetAge();
+        r.values[0] = h.GetRelativeInfectiousness();
+        r.values[1] = h.GetRelativeSusceptibility();
+        return r;
+}
+
+EventRecord EventRecord::ImportCases(unsigned short int simDay, unsigned int count)
+{
+        EventRecord r{};
+        r.tag     = Tag::ImportCases;
+        r.sim_day = simDay;
+        r.ids[0]  = count;
+        return r;
+}
+
+string EventRecord::ToString() const
+{
+        switch (tag) {
+        case Tag::Contact: {
+                const auto t = static_cast<Id>(type);
+                return fmt::format("[CONT] {} {} {} {} {} {} {} {} {} {} {} {} {} {} {} {}", ids[0], ages[0], ages[1],
+                                   static_cast<unsigned int>(t == Id::Household),
+                                   static_cast<unsigned int>(t == Id::K12School),
+                                   static_cast<unsigned int>(t == Id::College),
+                                   static_cast<unsigned int>(t == Id::Workplace),
+                                   static_cast<unsigned int>(t == Id::PrimaryCommunity),
+                                   static_cast<unsigned int>(t == Id::SecondaryCommunity),
+                                   static_cast<unsigned int>(t == Id::HouseholdCluster),
+                                   static_cast<unsigned int>(t == Id::Collectivity), sim_day, values[0], values[1],
+                                   IsSet(*this, SECOND), IsSet(*this, FIRST));
+        }
+        case Tag::Transmission:
+                return fmt::format("[TRAN] {} {} {} {} {} {} {} {} {} {} {} {} {} {}", ids[1], ids[0], ages[1], ages[0],
+                                   ContactType::ToString(static_cast<Id>(type)), sim_day, ids[2], days[0], days[1],
+                                   days[2], days[3], IsSet(*this, FIRST), values[0], values[1]);
+        case Tag::TransmissionIncidence:
+                return fmt::format("[TRAN_M] {} {} {} {} {}", ages[1], sim_day, days[0], days[2], days[3]);
+        case Tag::Trace: {
+                const auto place = static_cast<TracePlace>(type);
+                if (place == TracePlace::Index) {
+                        return fmt::format("[TRACE] {} {} {} {} {} {} {} {} {} {}", ids[0], ages[0],
+                                           IsSet(*this, FIRST), IsSet(*this, SECOND), stride::ToString(place), ids[1],
+                                           ages[1], sim_day, ids[2], ids[3]);
+                }
+                return fmt::format("[TRACE] {} {} {} {} {} {} {} {} {} {}", ids[0], ages[0], IsSet(*this, FIRST),
+                                   IsSet(*this, SECOND), stride::ToString(place), ids[1], ages[1], sim_day, -1, -1);
+        }
+        case Tag::UniversalTest: return fmt::format("[UNITEST] {} {}", sim_day, ids[0]);
+        case Tag::UniversalTestIsolate:
+                return fmt::format("[UNITEST-ISOLATE] pool_id={} household_id={} indiv_id={} infected?={} "
+                                   "isolation_delay={} sim_day={}",
+                                   ids[0], ids[1], ids[2], IsSet(*this, FIRST), ids[3], sim_day);
+        case Tag::Primary:
+                return fmt::format("[PRIM] {} {} {} {} {} {} {} {} {} {} {} {} {} {}", ids[0], -1, ages[0], -1, -1,
+                                   sim_day, ids[0], days[0], days[1], days[2], days[3], -1, values[0], values[1]);
+        case Tag::ImportCases: return fmt::format("[IMPORT-CASES] sim_day={} count={}", sim_day, ids[0]);
+        }
+        throw runtime_error("EventRecord::ToString> Invalid tag.");
+}
+
+} // namespace stride
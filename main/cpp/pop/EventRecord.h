@@ -0,0 +1,117 @@
+/*
+ *  This is free software: you can redistribute it and/or modify it
+ *  under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  any later version.
+ *  The software is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *  You should have received a copy of the GNU General Public License
+ *  along with the software. If not, see <http://www.gnu.org/licenses/>.
+ *
+ *  Copyright 2020, Willem L, Kuylen E, Broeckhove J
+ */
+
+/**
+ * @file
+ * Header for the EventRecord class.
+ */
+
+#pragma once
+
+#include "contact/ContactType.h"
+
+#include <cstdint>
+#include <string>
+#include <type_traits>
+
+namespace stride {
+
+class Person;
+
+/**
+ * Fixed-width record of an event in the simulation (contact, transmission, tracing, testing,
+ * seeded and imported infections).
+ * The record holds the data of one line of the event log; ToString formats that line exactly
+ * as the text event log has it, so a binary log of records can be decoded to the text log.
+ */
+struct EventRecord
+{
+public:
+        /// Kind of event, i.e. the tag of the line in the text log.
+        enum class Tag : std::uint8_t
+        {
+                Contact               = 0U, ///< [CONT]
+                Transmission          = 1U, ///< [TRAN]
+                TransmissionIncidence = 2U, ///< [TRAN_M]
+                Trace                 = 3U, ///< [TRACE]
+                UniversalTest         = 4U, ///< [UNITEST]
+                UniversalTestIsolate  = 5U, ///< [UNITEST-ISOLATE]
+                Primary               = 6U, ///< [PRIM]
+                ImportCases           = 7U  ///< [IMPORT-CASES]
+        };
+
+        /// Setting of a traced contact in [TRACE] records.
+        enum class TracePlace : std::uint8_t
+        {
+                School    = 0U,
+                Household = 1U,
+                Community = 2U,
+                Workplace = 3U,
+                Index     = 4U
+        };
+
+public:
+        /// [CONT] record: contact of survey participant p1 with p2.
+        static EventRecord Contact(const Person* p1, const Person* p2, ContactType::Id type, unsigned short int simDay,
+                                   double cProb, double tProb);
+
+        /// [TRAN] record: transmission from p1 to p2, with the given relative infectiousness.
+        static EventRecord Transmission(const Person* p1, const Person* p2, ContactType::Id type,
+                                        unsigned short int simDay, unsigned int idIndexCase,
+                                        double relInfectiousness);
+
+        /// [TRAN_M] record: incidence of p2.
+        static EventRecord TransmissionIncidence(const Person* p2, unsigned short int simDay);
+
+        /// [TRACE] record for a traced contact of the index case.
+        static EventRecord Trace(const Person* contact, TracePlace place, const Person* indexCase,
+                                 unsigned short int simDay);
+
+        /// [TRACE] record for the index case, with the size of its register and the number of contacts tested.
+        static EventRecord TraceIndex(const Person* indexCase, unsigned short int simDay, unsigned int numRegistered,
+                                      unsigned int numTested);
+
+        /// [UNITEST] record for a tested pool.
+        static EventRecord UniversalTest(unsigned short int simDay, unsigned int dayInSweep);
+
+        /// [UNITEST-ISOLATE] record for an isolated member of a tested pool.
+        static EventRecord UniversalTestIsolate(unsigned int poolId, const Person* p, unsigned int isolationDelay,
+                                                unsigned short int simDay);
+
+        /// [PRIM] record: seeded or imported infection of p.
+        static EventRecord Primary(const Person* p, unsigned short int simDay);
+
+        /// [IMPORT-CASES] record: number of cases imported on the day.
+        static EventRecord ImportCases(unsigned short int simDay, unsigned int count);
+
+        /// The line of the text event log.
+        std::string ToString() const;
+
+public:
+        Tag                tag;       ///< Kind of event.
+        std::uint8_t       type;      ///< ContactType::Id or TracePlace.
+        std::uint8_t       flags;     ///< Booleans, see the factory functions.
+        std::uint8_t       padding;   ///< Unused.
+        unsigned short int sim_day;   ///< Simulation day.
+        unsigned short int days[4];   ///< Disease counters.
+        unsigned int       ids[4];    ///< Person, pool or index case ids; counts.
+        float              ages[2];   ///< Ages of the persons.
+        double             values[2]; ///< Probabilities, relative infectiousness/susceptibility.
+};
+
+static_assert(std::is_trivially_copyable<EventRecord>::value, "EventRecord is written as raw bytes");
+static_assert(sizeof(EventRecord) == 56, "EventRecord has a fixed width");
+
+} // namespace stride
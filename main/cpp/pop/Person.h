@@ -24,10 +24,11 @@
 #include "contact/ContactType.h"
 #include "contact/IdSubscriptArray.h"
 #include "disease/Health.h"
+#include "pop/PopTopology.h"
 #include "util/RnHandler.h"
 
 #include <cstddef>
-#include <queue>
+#include <cstdint>
 #include <vector>
 
 
@@ -35,40 +36,26 @@ namespace stride {
 
 /**
  * Store and handle person data.
+ * The Person holds the state of the person in a run; its age and pools, which no run changes,
+ * are in the PopTopology that the runs share (the person refers to its record there).
+ * The data that the daily sweeps (loading the contact pools) touch for every person is
+ * kept in the Person itself and packed (id, pool slots, health, absence and flag bits).
+ * The presence in the contact pools is not stored: ContactPolicy derives
+ * it from the type of day and school closures, except for the absences of a symptomatic
+ * person (drawn daily) and isolation. The contact register, which only a tracing index case
+ * needs, is kept in the ContactRegisters of the population; the person holds its handle. The
+ * start and end of an isolation are scheduled in the TimingWheel of the simulator.
  */
 class Person
 {
 public:
-        enum EventType { StartIsolation, EndIsolation };
-        class Event 
-        {
-            public:
-                Event(unsigned int t, EventType type) : 
-                    m_t(t), m_type(type) {}
-                unsigned int GetTime() const { return m_t; }
-                EventType GetType() const { return m_type; }
-
-            private:
-                unsigned int m_t;
-                EventType m_type;
-        };
+        /// Default construction (for population vector), without age and pools.
+        Person() : Person(0U, nullptr) {}
 
-public:
-        /// Default construction (for population vector).
-        Person() : m_age(0.0), m_id(0), m_pool_ids(), m_health(), m_in_pools(), m_is_participant(),
-		m_non_complier(), m_is_tracing_index(false), m_contact_tracing_list(),
-        m_isolated(false), m_events() {}
-
-        /// Constructor: set the person data.
-        Person(unsigned int id, float age, unsigned int householdId, unsigned int k12SchoolId, unsigned int collegeId,
-               unsigned int workId, unsigned int primaryCommunityId, unsigned int secondaryCommunityId, unsigned int householdClusterId,
-			   unsigned int collectivityId)
-            : m_age(age), m_id(id), m_pool_ids{householdId, k12SchoolId,        collegeId,
-                                               workId,      primaryCommunityId, secondaryCommunityId,
-											   householdClusterId, collectivityId},
-              m_health(), m_in_pools(true), m_is_participant(false), m_non_complier(false),
-			  m_is_tracing_index(false), m_contact_tracing_list(), m_isolated(false),
-              m_events()
+        /// Constructor: the person with the given id and its age and pools, in the state as built.
+        Person(unsigned int id, const PersonTopology* topology)
+            : m_health(), m_topology(topology), m_contact_register(0U), m_id(id), m_pool_slots(), m_absent(false),
+              m_non_complier(false), m_is_participant(false), m_is_tracing_index(false), m_isolated(false)
         {
         }
 
@@ -76,7 +63,7 @@ public:
         bool operator!=(const Person& p) const { return p.m_id != m_id; }
 
         /// Get the age.
-        float GetAge() const { return m_age; }
+        float GetAge() const { return static_cast<float>(m_topology->age); }
 
         /// Return person's health status.
         Health& GetHealth() { return m_health; }
@@ -88,10 +75,16 @@ public:
         unsigned int GetId() const { return m_id; }
 
         /// Get ID of contactpool_type
-        unsigned int GetPoolId(const ContactType::Id& poolType) const { return m_pool_ids[poolType]; }
+        unsigned int GetPoolId(const ContactType::Id& poolType) const { return m_topology->pool_ids[poolType]; }
+
+        /// Get the index of this person in the members of its contactpool of the given type.
+        unsigned int GetPoolSlot(const ContactType::Id& poolType) const { return m_pool_slots[poolType]; }
 
-        /// Check if a person is present today in a given contact pool
-        bool IsInPool(const ContactType::Id& poolType) const { return m_in_pools[poolType]; }
+        /// Set the index of this person in the members of its contactpool of the given type.
+        void SetPoolSlot(const ContactType::Id& poolType, unsigned int slot) { m_pool_slots[poolType] = slot; }
+
+        /// Is the person absent today from pools of the given type because of symptoms?
+        bool IsAbsent(const ContactType::Id& poolType) const { return m_health.IsSymptomatic() && m_absent[poolType]; }
 
         /// Does this person participates in the social contact study?
         bool IsSurveyParticipant() const { return m_is_participant; }
@@ -99,31 +92,14 @@ public:
         /// Participate in social contact study and log person details
         void ParticipateInSurvey() { m_is_participant = true; }
 
-        //Isolate the individual over an interval of days 
-        void Isolate(unsigned int simDay, unsigned int from, unsigned int to); 
+        /// Start (true) or end (false) the isolation of the individual (see TimingWheel).
+        void SetIsolated(bool isolated) { m_isolated = isolated; }
 
         //Is the individual being isolated?
         bool InIsolation() const { return m_isolated; }
 
-        /// Daily update of the isolation status, health status and presence in contact pools.
-        void Update(bool isRegularWeekday, bool isK12SchoolOff, bool isCollegeOff,
-        		bool isHouseholdClusteringAllowed,
-        		bool isIsolatedFromHousehold, 
-				util::RnHandler& rnHandler,
-                const std::shared_ptr<Calendar> calendar);
-
-        /// Set the age of the person
-        void SetAge(unsigned int newAge) { m_age = newAge; }
-
-        /// Set the id.
-        void SetId(unsigned int id) { m_id = id; }
-
-        /// Sets (for the type of ContactPool) the Id of the ContactPool the person belongs to.
-        void SetPoolId(ContactType::Id type, unsigned int poolId)
-        {
-                m_pool_ids[type] = poolId;
-                m_in_pools[type] = (poolId != 0); // Means present in Household, absent elsewhere.
-        }
+        /// Draw today's absences of a symptomatic person from work/school and community pools.
+        void DrawAbsences(util::RnHandler& rnHandler);
 
          /// Set this person as index case for track&trace strategies
         void SetTracingIndexCase(){ m_is_tracing_index = true; }
@@ -131,61 +107,49 @@ public:
         /// Set this person as index case for track&trace strategies
         bool IsTracingIndexCase() const { return m_is_tracing_index; }
 
-        /// Register contact, if this person is an index case for track&trace
-        void RegisterContact(Person* p) {
-        	if(m_is_tracing_index){
-        		m_contact_tracing_list.push_back(p);
-        	}
-        }
+        /// Get the handle of the contact register (see ContactRegisters), 0 if there is none.
+        unsigned int GetContactRegister() const { return m_contact_register; }
 
-        /// Get register with contacts during infected period
-        std::vector<Person*>& GetContactRegister () {
-        	return m_contact_tracing_list;
-        }
+        /// Set the handle of the contact register (see ContactRegisters).
+        void SetContactRegister(unsigned int handle) { m_contact_register = handle; }
 
         void SetNonComplier(const ContactType::Id& poolType) {  m_non_complier[poolType] = true; }
 
         bool IsNonComplier(const ContactType::Id& poolType) const { return m_non_complier[poolType]; }
 
 private:
-        ///< Schedule an event, if the event should take place on simDay, it is executed right away.
-        void ScheduleEvent(unsigned int simDay, const Event &event);
-        ///< Check whether there are events to execute, and if so, execute them.
-        void UpdateEvents(unsigned int simDay);
+        /// Restores the state of the person (over the topology of its population).
+        friend class SimCheckpoint;
 
 private:
-        float        m_age; ///< The age.
-        unsigned int m_id;  ///< The id.
-
-        ///< Ids (school, work, etc) of pools you belong to Id value 0 means you do not belong to any
-        ///< pool of that type (e.g. school and work are mutually exclusive).
-        ContactType::IdSubscriptArray<unsigned int> m_pool_ids;
-
         ///< Health info (immune, infected, etc) for this person.
         Health m_health;
 
-        ///< Is person present/absent in pools of each of the types (school, work, etc)?
-        ContactType::IdSubscriptArray<bool> m_in_pools;
+        ///< The age and pools of the person (shared by the runs).
+        const PersonTopology* m_topology;
 
-        ///< Is this a participant in the social contact study?
-        bool m_is_participant;
+        ///< Handle of the contact register (tracing index case), 0 if there is none.
+        unsigned int m_contact_register;
+
+        unsigned int m_id;  ///< The id.
+
+        ///< Index of the person in the members of the pool of each of the types (maintained by ContactPool).
+        ContactType::IdSubscriptArray<unsigned int> m_pool_slots;
+
+        ///< Is the person absent today from pools of each of the types because of symptoms?
+        ContactType::IdSubscriptArray<bool> m_absent;
 
         ///< Is the person a non-complier to social distancing measures in the contact pools they belong to?
         ContactType::IdSubscriptArray<bool> m_non_complier;
 
-        ///< Is this an index case for track,trace, isolate strategies
-        bool m_is_tracing_index;
-
-        ///< Vector with the id of contacts during infected period
-        std::vector<Person*> m_contact_tracing_list;
+        ///< Is this a participant in the social contact study?
+        bool m_is_participant : 1;
 
-        ///< Isolation state of the individual 
-        unsigned int m_isolated;
+        ///< Is this an index case for track,trace, isolate strategies
+        bool m_is_tracing_index : 1;
 
-        ///< Event queue
-        std::priority_queue<Event, std::vector<Event>, std::greater<Event>> m_events;
+        ///< Isolation state of the individual
+        bool m_isolated : 1;
 };
 
-bool operator>(const Person::Event& lhs, const Person::Event& rhs);
-
 } // namespace stride
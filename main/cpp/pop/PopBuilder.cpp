@@ -22,14 +22,19 @@
 #include "contact/ContactType.h"
 #include "contact/IdSubscriptArray.h"
 #include "pop/Population.h"
+#include "pop/PopSnapshot.h"
 #include "pop/SurveySeeder.h"
 #include "util/FileSys.h"
+#include "util/MappedFile.h"
 #include "util/RnMan.h"
 #include "util/StringUtils.h"
 #include "util/LogUtils.h"
 
 #include <boost/property_tree/ptree.hpp>
-#include <fstream>
+#include <algorithm>
+#include <cstring>
+#include <numeric>
+#include <omp.h>
 #include "PopBuilder.h"
 #include "../contact/EventLogMode.h"
 
@@ -41,6 +46,51 @@ using namespace util;
 using namespace boost::property_tree;
 using namespace std;
 
+namespace {
+
+/// Call f with the begin and end (without line terminator) of each non-blank line in [begin, end).
+template <typename F>
+void ForEachLine(const char* begin, const char* end, F f)
+{
+        while (begin < end) {
+                auto eol = static_cast<const char*>(memchr(begin, '\n', static_cast<size_t>(end - begin)));
+                if (eol == nullptr) {
+                        eol = end;
+                }
+                auto last = eol;
+                while (last > begin && (last[-1] == '\r' || last[-1] == ' ')) {
+                        --last;
+                }
+                if (last > begin) {
+                        f(begin, last);
+                }
+                begin = eol + 1;
+        }
+}
+
+/// Parse the unsigned integer at the start of the field at pos (like FromString, an optional
+/// fraction is dropped) and move pos past the separator that ends the field.
+unsigned int ParseField(const char*& pos, const char* end)
+{
+        while (pos < end && (*pos == ' ' || *pos == '"')) {
+                ++pos;
+        }
+        unsigned int value = 0U;
+        while (pos < end && *pos >= '0' && *pos <= '9') {
+                value = 10U * value + static_cast<unsigned int>(*pos - '0');
+                ++pos;
+        }
+        while (pos < end && *pos != ',') {
+                ++pos;
+        }
+        if (pos < end) {
+                ++pos;
+        }
+        return value;
+}
+
+} // namespace
+
 PopBuilder::PopBuilder(const boost::property_tree::ptree& config,
                                        std::shared_ptr<spdlog::logger> strideLogger)
     : m_config(config), m_stride_logger(std::move(strideLogger))
@@ -50,120 +100,192 @@ PopBuilder::PopBuilder(const boost::property_tree::ptree& config,
         }
 }
 
-shared_ptr<Population> PopBuilder::MakePersons(shared_ptr<Population> pop)
+filesys::path PopBuilder::GetPopulationFile() const
 {
-        //------------------------------------------------
-        // Read persons from file.
-        //------------------------------------------------
         const auto fileName = m_config.get<string>("run.population_file");
-        m_stride_logger->info("Building default population from file {}.", fileName);
-
         const auto use_install_dirs = m_config.get<bool>("run.use_install_dirs");
         const auto filePath         = (use_install_dirs) ? FileSys::GetDataDir() /= fileName : filesys::path(fileName);
         if (!is_regular_file(filePath)) {
                 throw runtime_error(string(__func__) + "> Population file " + filePath.string() + " not present.");
         }
+        return filePath;
+}
 
-        ifstream popFile;
-        popFile.open(filePath.string());
-        if (!popFile.is_open()) {
-                throw runtime_error(string(__func__) + "> Error opening population file " + filePath.string());
-        }
+void PopBuilder::MakePersons(PopTopology& topology)
+{
+        //------------------------------------------------
+        // Read persons from file.
+        //------------------------------------------------
+        const auto filePath = GetPopulationFile();
+        m_stride_logger->info("Building default population from file {}.", filePath.string());
+        const MappedFile popFile(filePath.string());
 
         // get age break between 2 school types
         //TODO: rename school types and/or add 3rd for secondary school
         const unsigned int age_break_school_types = m_config.get<unsigned int>("run.age_break_school_types",18);
 
-        string line;
-        getline(popFile, line); // step over file header
-        auto headers   = Split(line, ",");
-
-        unsigned int person_id = 0U;
-
-        while (getline(popFile, line)) {
-                const auto values               = Split(line, ",");
-                const auto age                  = FromString<unsigned int>(values[0]);
-                const auto householdId          = FromString<unsigned int>(values[1]);
-                auto schoolId                   = FromString<unsigned int>(values[2]);
-                const auto workId               = FromString<unsigned int>(values[3]);
-                const auto primaryCommunityId   = FromString<unsigned int>(values[4]);
-                const auto secondaryCommunityId = FromString<unsigned int>(values[5]);
+        // The header fixes the layout: age, household, school, work, primary and secondary community,
+        // optionally followed by a household cluster or a collectivity.
+        const char* data   = popFile.begin();
+        const auto  header = static_cast<const char*>(memchr(data, '\n', popFile.size()));
+        const auto  body    = (header == nullptr) ? popFile.end() : header + 1;
+        const auto  headers = Split(string(data, (header == nullptr) ? popFile.end() : header), ",");
+        string      optional;
+        if (headers.size() == 7) {
+                optional = Trim(ToString(headers[6]), " \r\"");
+        }
+        const bool hasHouseholdCluster = (optional == "household_cluster_id");
+        const bool hasCollectivity     = (optional == "collectivity_id");
 
-                unsigned int householdClusterId = 0;
-                if(values.size() == 7 && Trim(ToString(headers[6]),ToString('"')) == "household_cluster_id"){
-                	householdClusterId = FromString<unsigned int>(values[6]);
+        // Line-aligned chunks, one per thread.
+        const auto   numThreads = max(1U, m_config.get<unsigned int>("run.num_threads", 1U));
+        const auto   size       = static_cast<size_t>(popFile.end() - body);
+        vector<const char*> bounds{body};
+        for (unsigned int c = 1U; c < numThreads; c++) {
+                auto pos = max(bounds.back(), body + size * c / numThreads);
+                while (pos < popFile.end() && pos > body && pos[-1] != '\n') {
+                        ++pos;
                 }
+                bounds.emplace_back(pos);
+        }
+        bounds.emplace_back(popFile.end());
 
-                unsigned int collectivityId = 0;
+        // Count the persons per chunk, to number them in order of the file.
+        const auto   numChunks = static_cast<long>(numThreads);
+        vector<size_t> first(numThreads + 1U, 0U);
+#pragma omp parallel for num_threads(numThreads) schedule(static)
+        for (long c = 0; c < numChunks; c++) {
+                size_t count = 0U;
+                ForEachLine(bounds[c], bounds[c + 1], [&count](const char*, const char*) { ++count; });
+                first[c + 1] = count;
+        }
+        partial_sum(first.begin(), first.end(), first.begin());
+        auto& persons = topology.m_persons;
+        persons.resize(first.back());
 
-				if(values.size() == 7 && Trim(ToString(headers[6]),ToString('"')) == "collectivity_id"){
-					collectivityId = FromString<unsigned int>(values[6]);
-				}
+        // Parse the chunks.
+#pragma omp parallel for num_threads(numThreads) schedule(static)
+        for (long c = 0; c < numChunks; c++) {
+                auto person_id = static_cast<unsigned int>(first[c]);
+                ForEachLine(bounds[c], bounds[c + 1], [&](const char* pos, const char* end) {
+                        const auto age                  = ParseField(pos, end);
+                        const auto householdId          = ParseField(pos, end);
+                        auto       schoolId             = ParseField(pos, end);
+                        const auto workId               = ParseField(pos, end);
+                        const auto primaryCommunityId   = ParseField(pos, end);
+                        const auto secondaryCommunityId = ParseField(pos, end);
+                        const auto optionalId           = ParseField(pos, end);
 
-                //TODO: rename school types to current approach
-                unsigned int collegeId = 0;
-                if(schoolId != 0 && age >= age_break_school_types && age < 23){
-                	collegeId = schoolId;
-                	schoolId = 0;
-                }
+                        const unsigned int householdClusterId = hasHouseholdCluster ? optionalId : 0U;
+                        const unsigned int collectivityId     = hasCollectivity ? optionalId : 0U;
 
-                pop->CreatePerson(person_id, age, householdId, schoolId, collegeId, workId, primaryCommunityId,
-                                  secondaryCommunityId, householdClusterId, collectivityId);
-                ++person_id;
-        }
+                        //TODO: rename school types to current approach
+                        unsigned int collegeId = 0;
+                        if(schoolId != 0 && age >= age_break_school_types && age < 23){
+                                collegeId = schoolId;
+                                schoolId = 0;
+                        }
 
-        popFile.close();
+                        persons[person_id] = PersonTopology(static_cast<uint8_t>(age),
+                                                            {householdId, schoolId, collegeId, workId,
+                                                             primaryCommunityId, secondaryCommunityId,
+                                                             householdClusterId, collectivityId});
+                        ++person_id;
+                });
+        }
 
         m_stride_logger->trace("Done building default population.");
-
-        return pop;
 }
 
 shared_ptr<Population> PopBuilder::Build(shared_ptr<Population> pop)
 {
         //------------------------------------------------
-        // Add persons
+        // Load the snapshot of an earlier build, if cached
         //------------------------------------------------
-        MakePersons(pop);
+        const auto    cacheDir   = m_config.get<string>("run.population_cache_dir", "");
+        const auto    numThreads = max(1U, m_config.get<unsigned int>("run.num_threads", 1U));
+        const auto    topology   = make_shared<PopTopology>();
+        filesys::path snapshot;
+        bool          loaded = false;
+        if (!cacheDir.empty()) {
+                const auto options = "age_break_school_types=" +
+                                     to_string(m_config.get<unsigned int>("run.age_break_school_types", 18));
+                snapshot = PopSnapshot::GetPath(cacheDir, GetPopulationFile(), options);
+                loaded   = PopSnapshot::Load(snapshot, *topology);
+                if (loaded) {
+                        m_stride_logger->info("Loaded population snapshot {}.", snapshot.string());
+                }
+        }
 
-        // --------------------------------------------------------------
-        // Determine maximum pool ids in population.
-        // --------------------------------------------------------------
-        IdSubscriptArray<unsigned int> maxIds{0U};
-        for (const auto& p : *pop) {
-                for (Id typ : IdList) {
-                        maxIds[typ] = max(maxIds[typ], p.GetPoolId(typ));
+        //------------------------------------------------
+        // Add persons and pools to the topology
+        //------------------------------------------------
+        if (!loaded) {
+                MakePersons(*topology);
+                topology->MakePools(numThreads);
+                if (!snapshot.empty()) {
+                        PopSnapshot::Save(snapshot, *topology);
+                        m_stride_logger->info("Saved population snapshot {}.", snapshot.string());
                 }
         }
+
+        //------------------------------------------------
+        // The persons and pools of the population
+        //------------------------------------------------
+        pop->m_topology = topology;
+        MakeState(*pop);
+        return pop;
+}
+
+shared_ptr<Population> PopBuilder::Share(const Population& source, shared_ptr<Population> pop)
+{
+        pop->m_topology = source.m_topology;
+        MakeState(*pop);
+        return pop;
+}
+
+void PopBuilder::MakeState(Population& pop)
+{
         // --------------------------------------------------------------
-        // Initialize poolSys with empty ContactPools (even for Id=0).
+        // The persons, as built, each referring to its age and pools in
+        // the topology.
         // --------------------------------------------------------------
-        for (Id typ : IdList) {
-                for (unsigned int i = 1; i < maxIds[typ] + 1; i++) {
-                        pop->RefPoolSys().CreateContactPool(typ);
-                }
+        const auto& topology   = *pop.m_topology;
+        const auto  numThreads = max(1U, m_config.get<unsigned int>("run.num_threads", 1U));
+        const auto  numPersons = static_cast<long>(topology.size());
+        pop.resize(topology.size());
+#pragma omp parallel for num_threads(numThreads) schedule(static)
+        for (long i = 0; i < numPersons; i++) {
+                pop[i] = Person(static_cast<unsigned int>(i), &topology[static_cast<size_t>(i)]);
         }
 
         // --------------------------------------------------------------
-        // Insert persons (pointers) in their contactpools. Having Id 0
-        // means "not belonging pool of that type" (e.g. school/ work -
-        // cannot belong to both, or e.g. out-of-work).
+        // The types of pools are independent, so they are built in parallel.
+        // Per type: initialize poolSys with empty ContactPools (even for
+        // Id=0) and insert persons (pointers) in their contactpools, in
+        // order of id, as in the topology. Having Id 0 means "not belonging
+        // pool of that type" (e.g. school/ work - cannot belong to both, or
+        // e.g. out-of-work).
         //
         // Pools are uniquely identified by (type, subscript) and a Person
         // belongs, per type, to the pool with subscript p.GetPoolId(type).
         // Defensive measure: we have a pool for Id 0 and leave it empty.
         // --------------------------------------------------------------
-        for (auto& p : *pop) {
-                for (Id typ : IdList) {
-                        const auto poolId = p.GetPoolId(typ);
-                        if (poolId > 0) {
-                                pop->RefPoolSys().RefPools(typ)[poolId].AddMember(&p);
+        auto&      poolSys  = pop.RefPoolSys();
+        const auto numTypes = static_cast<long>(NumOfTypes());
+#pragma omp parallel for num_threads(numThreads) schedule(dynamic)
+        for (long t = 0; t < numTypes; t++) {
+                const auto typ   = *(IdList.begin() + t);
+                auto&      pools = poolSys.RefPools(typ);
+                for (size_t i = 1U; i < topology.GetNumPools(typ); i++) {
+                        const auto numMembers = topology.GetNumMembers(typ, i);
+                        const auto members    = topology.GetMembers(typ, i);
+                        poolSys.CreateContactPool(typ)->ReserveMembers(numMembers);
+                        for (size_t m = 0U; m < numMembers; m++) {
+                                pools[i].AddMember(&pop[members[m]]);
                         }
                 }
         }
-
-
-        return pop;
 }
 
 } // namespace stride
@@ -21,6 +21,8 @@
 
 #pragma once
 
+#include "util/FileSys.h"
+
 #include <boost/property_tree/ptree_fwd.hpp>
 #include <memory>
 #include <spdlog/logger.h>
@@ -28,6 +30,7 @@
 namespace stride {
 
 class Population;
+class PopTopology;
 namespace util {
 class RnMan;
 }
@@ -47,15 +50,30 @@ public:
         /// Build Population and return it afterwards.
         /// The steps are:
         /// - Check input data.
-        /// - Read persons from file and instantiate them.
-        /// - Fill up the various type of contactpools.
-        /// - Seed the population with contact survey participants.
+        /// - Read persons from file into the topology (age and pools).
+        /// - Fill up the members of the various type of contactpools in the topology.
+        /// - Instantiate the persons and the contactpools of the population over the topology.
+        /// With a population cache directory (run.population_cache_dir), the topology is loaded
+        /// from the snapshot of an earlier build (see PopSnapshot) if there is one, and a
+        /// snapshot is written otherwise.
         std::shared_ptr<Population> Build(std::shared_ptr<Population> pop);
 
+        /// Build Population over the topology of a population built earlier (which it shares):
+        /// the persons as built (see Population::Reset) and their contactpools, without reading
+        /// the population file.
+        std::shared_ptr<Population> Share(const Population& source, std::shared_ptr<Population> pop);
+
 
 private:
-        /// Generates pop's individuals and return pop.
-        std::shared_ptr<Population> MakePersons(std::shared_ptr<Population> pop);
+        /// Path of the population file.
+        filesys::path GetPopulationFile() const;
+
+        /// Read the age and pools of the individuals into the topology.
+        void MakePersons(PopTopology& topology);
+
+        /// Instantiate the individuals of the population and fill up its contactpools, as in
+        /// its topology.
+        void MakeState(Population& pop);
 
         const boost::property_tree::ptree& m_config;        ///< Configuration property tree.
         std::shared_ptr<spdlog::logger>    m_stride_logger; /// Logger for build process.
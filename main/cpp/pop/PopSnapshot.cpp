@@ -0,0 +1,248 @@
+/*
+ *  This is free software: you can redistribute it and/or modify it
+ *  under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  any later version.
+ *  The software is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *  You should have received a copy of the GNU General Public License
+ *  along with the software. If not, see <http://www.gnu.org/licenses/>.
+ *
+ *  Copyright 2020, Willem L, Kuylen E, Broeckhove J
+ */
+
+/**
+ * @file
+ * Implementation of the PopSnapshot class.
+ */
+
+#include "PopSnapshot.h"
+
+#include "contact/ContactType.h"
+#include "pop/PopTopology.h"
+#include "util/MappedFile.h"
+
+#include <sha1.h>
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <memory>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+namespace stride {
+
+using namespace std;
+using namespace stride::ContactType;
+using namespace stride::util;
+
+namespace {
+
+/// Magic and format version of the snapshot.
+constexpr array<char, 8> MAGIC{{'S', 'T', 'R', 'I', 'D', 'E', 'P', 'S'}};
+constexpr uint32_t       VERSION = 3U;
+
+/// Header of the snapshot, followed by a probe person and the persons (raw PersonTopology, the
+/// age and pools) and, per type of pool, the number of pools (including the unused pool 0), the
+/// offsets of their members and the members (ids).
+struct Header
+{
+        array<char, 8> magic;
+        uint32_t       version;
+        uint32_t       person_size;
+        uint32_t       num_types;
+        uint32_t       reserved;
+        uint64_t       num_persons;
+};
+
+static_assert(is_trivially_copyable<PersonTopology>::value, "PopSnapshot> PersonTopology is stored in raw form");
+
+/// Person with distinct values in its fields, stored (raw) with the snapshot: read back with
+/// another layout of PersonTopology (fields in another order), its values differ.
+PersonTopology GetProbe() { return PersonTopology(1U, {2U, 3U, 4U, 5U, 6U, 7U, 8U, 9U}); }
+
+/// Has the person the values of the probe?
+bool IsProbe(const PersonTopology& p)
+{
+        const auto probe = GetProbe();
+        bool       same  = p.age == probe.age;
+        for (Id typ : IdList) {
+                same = same && p.pool_ids[typ] == probe.pool_ids[typ];
+        }
+        return same;
+}
+
+/// Reads consecutive values from the snapshot, false once it would read past the end.
+class Reader
+{
+public:
+        Reader(const char* begin, const char* end) : m_pos(begin), m_end(end) {}
+
+        /// Pointer to the next n bytes, nullptr if there are not that many.
+        const char* Take(size_t n)
+        {
+                if (static_cast<size_t>(m_end - m_pos) < n) {
+                        return nullptr;
+                }
+                const auto pos = m_pos;
+                m_pos += n;
+                return pos;
+        }
+
+        /// Read the value, false if there is none.
+        template <typename T>
+        bool Read(T& value)
+        {
+                const auto pos = Take(sizeof(T));
+                if (pos != nullptr) {
+                        memcpy(&value, pos, sizeof(T));
+                }
+                return pos != nullptr;
+        }
+
+private:
+        const char* m_pos;
+        const char* m_end;
+};
+
+} // namespace
+
+filesys::path PopSnapshot::GetPath(const filesys::path& cacheDir, const filesys::path& popFile, const string& options)
+{
+        // the SHA1 of the contents, as remembered for this version of the population file
+        const auto source = filesys::canonical(popFile);
+        const auto stamp  = sha1(source.string() + "|" + to_string(filesys::file_size(source)) + "|" +
+                                to_string(filesys::last_write_time(source)));
+        const auto stampPath = cacheDir / (stamp + ".src");
+        string     contentSha1;
+        {
+                ifstream is(stampPath.string());
+                is >> contentSha1;
+        }
+        if (contentSha1.size() != 40U) {
+                contentSha1 = SHA1::from_file(source.string());
+                filesys::create_directories(cacheDir);
+                ofstream os(stampPath.string());
+                os << contentSha1 << endl;
+        }
+        return cacheDir / ("pop_" + sha1(contentSha1 + "|" + options + "|" + to_string(VERSION)) + ".bin");
+}
+
+bool PopSnapshot::Load(const filesys::path& path, PopTopology& topology)
+{
+        if (!filesys::is_regular_file(path)) {
+                return false;
+        }
+        const MappedFile file(path.string());
+        Reader           reader(file.begin(), file.end());
+        Header           header{};
+        if (!reader.Read(header) || header.magic != MAGIC || header.version != VERSION ||
+            header.person_size != sizeof(PersonTopology) || header.num_types != NumOfTypes() ||
+            header.num_persons > file.size()) {
+                return false;
+        }
+        PersonTopology probe;
+        if (!reader.Read(probe) || !IsProbe(probe)) {
+                return false;
+        }
+        const auto raw = reader.Take(header.num_persons * sizeof(PersonTopology));
+        if (raw == nullptr) {
+                return false;
+        }
+        vector<PersonTopology> persons(header.num_persons);
+        memcpy(static_cast<void*>(persons.data()), raw, persons.size() * sizeof(PersonTopology));
+
+        // The pools of each type: number, member offsets and members (in increasing order of id),
+        // consistent with the pools of the persons. Everything is checked before the topology is
+        // filled, so that the caller can build it from the source instead.
+        IdSubscriptArray<vector<uint64_t>>     begin;
+        IdSubscriptArray<vector<unsigned int>> members;
+        for (Id typ : IdList) {
+                uint64_t numPools = 0U;
+                if (!reader.Read(numPools) || numPools == 0U || numPools > header.num_persons + 1U) {
+                        return false;
+                }
+                auto& offsets = begin[typ];
+                offsets.resize(numPools + 1U);
+                const auto rawOffsets = reader.Take(offsets.size() * sizeof(uint64_t));
+                if (rawOffsets == nullptr) {
+                        return false;
+                }
+                memcpy(offsets.data(), rawOffsets, offsets.size() * sizeof(uint64_t));
+                if (offsets[0] != 0U || !is_sorted(offsets.begin(), offsets.end()) ||
+                    offsets[numPools] > header.num_persons) {
+                        return false;
+                }
+                auto&      ids    = members[typ];
+                const auto rawIds = reader.Take(offsets[numPools] * sizeof(uint32_t));
+                if (rawIds == nullptr) {
+                        return false;
+                }
+                ids.resize(offsets[numPools]);
+                memcpy(ids.data(), rawIds, ids.size() * sizeof(uint32_t));
+
+                // each person with a pool of the type is a member of that pool only, once
+                uint64_t numMembers = 0U;
+                for (const auto& p : persons) {
+                        if (p.pool_ids[typ] >= numPools) {
+                                return false;
+                        }
+                        numMembers += (p.pool_ids[typ] > 0U) ? 1U : 0U;
+                }
+                if (numMembers != ids.size() || offsets[1] != 0U) {
+                        return false;
+                }
+                for (uint64_t i = 1U; i < numPools; i++) {
+                        for (auto m = offsets[i]; m < offsets[i + 1U]; m++) {
+                                if (ids[m] >= header.num_persons || persons[ids[m]].pool_ids[typ] != i ||
+                                    (m > offsets[i] && ids[m] <= ids[m - 1U])) {
+                                        return false;
+                                }
+                        }
+                }
+        }
+
+        topology.m_persons.swap(persons);
+        topology.m_begin.swap(begin);
+        topology.m_members.swap(members);
+        return true;
+}
+
+void PopSnapshot::Save(const filesys::path& path, const PopTopology& topology)
+{
+        filesys::create_directories(path.parent_path());
+        const auto tmpPath = path.parent_path() / filesys::unique_path("%%%%-%%%%-%%%%.tmp");
+        unique_ptr<FILE, int (*)(FILE*)> file(fopen(tmpPath.string().c_str(), "wb"), &fclose);
+        if (!file) {
+                throw runtime_error("PopSnapshot::Save> Cannot open file: " + tmpPath.string());
+        }
+
+        const auto&          persons = topology.m_persons;
+        const Header         header{MAGIC, VERSION, sizeof(PersonTopology), NumOfTypes(), 0U, persons.size()};
+        const PersonTopology probe = GetProbe();
+        bool                 ok    = fwrite(&header, sizeof(header), 1U, file.get()) == 1U;
+        ok = ok && fwrite(&probe, sizeof(PersonTopology), 1U, file.get()) == 1U;
+        ok = ok && fwrite(persons.data(), sizeof(PersonTopology), persons.size(), file.get()) == persons.size();
+        for (Id typ : IdList) {
+                const auto&    begin    = topology.m_begin[typ];
+                const auto&    ids      = topology.m_members[typ];
+                const uint64_t numPools = begin.size() - 1U;
+                ok = ok && fwrite(&numPools, sizeof(numPools), 1U, file.get()) == 1U;
+                ok = ok && fwrite(begin.data(), sizeof(uint64_t), begin.size(), file.get()) == begin.size();
+                ok = ok && fwrite(ids.data(), sizeof(uint32_t), ids.size(), file.get()) == ids.size();
+        }
+        ok = (fclose(file.release()) == 0) && ok;
+        if (!ok) {
+                filesys::remove(tmpPath);
+                throw runtime_error("PopSnapshot::Save> Cannot write file: " + tmpPath.string());
+        }
+        filesys::rename(tmpPath, path);
+}
+
+} // namespace stride
@@ -0,0 +1,57 @@
+/*
+ *  This is free software: you can redistribute it and/or modify it
+ *  under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  any later version.
+ *  The software is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *  You should have received a copy of the GNU General Public License
+ *  along with the software. If not, see <http://www.gnu.org/licenses/>.
+ *
+ *  Copyright 2020, Willem L, Kuylen E, Broeckhove J
+ */
+
+/**
+ * @file
+ * Header for the PopSnapshot class.
+ */
+
+#pragma once
+
+#include "util/FileSys.h"
+
+#include <string>
+
+namespace stride {
+
+class PopTopology;
+
+/**
+ * Binary snapshot of the topology of a population as built by PopBuilder: the age and pools
+ * of the persons and the membership of the contact pools (see PopTopology). The snapshot is
+ * keyed by the SHA1 of the contents of the population file and of the builder options; to
+ * avoid hashing a large file on every run, the SHA1 of the contents is remembered in a stamp
+ * file that is keyed by the path, size and modification time of the population file. A
+ * snapshot is written to a temporary file that is then renamed, so concurrent runs never read
+ * a partial snapshot. A snapshot of another format version or layout of PersonTopology (its
+ * size, and a probe person read back), or with member offsets or ids out of range or members
+ * that do not match the pools of the persons, is ignored (and overwritten).
+ */
+class PopSnapshot
+{
+public:
+        /// Path of the snapshot (in the cache directory) for the population file and builder options.
+        static filesys::path GetPath(const filesys::path& cacheDir, const filesys::path& popFile,
+                                     const std::string& options);
+
+        /// Load the snapshot into the empty topology; false (and the topology left as it is) if
+        /// there is no valid snapshot.
+        static bool Load(const filesys::path& path, PopTopology& topology);
+
+        /// Write the snapshot of the topology.
+        static void Save(const filesys::path& path, const PopTopology& topology);
+};
+
+} // namespace stride
@@ -0,0 +1,66 @@
+/*
+ *  This is free software: you can redistribute it and/or modify it
+ *  under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  any later version.
+ *  The software is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *  You should have received a copy of the GNU General Public License
+ *  along with the software. If not, see <http://www.gnu.org/licenses/>.
+ *
+ *  Copyright 2020, Willem L, Kuylen E, Broeckhove J
+ */
+
+/**
+ * @file
+ * Implementation of the PopTopology class.
+ */
+
+#include "PopTopology.h"
+
+#include <numeric>
+
+namespace stride {
+
+using namespace std;
+using namespace stride::ContactType;
+
+void PopTopology::MakePools(unsigned int numThreads)
+{
+        // --------------------------------------------------------------
+        // Per type: count the members of each pool (which gives the maximum
+        // pool id), turn the counts into offsets and place the members, in
+        // order of id. Pool 0 (no pool of the type) is left empty.
+        // --------------------------------------------------------------
+        const auto numTypes = static_cast<long>(NumOfTypes());
+#pragma omp parallel for num_threads(numThreads) schedule(dynamic)
+        for (long t = 0; t < numTypes; t++) {
+                const auto typ   = *(IdList.begin() + t);
+                auto&      begin = m_begin[typ];
+                begin.assign(2U, 0U);
+                for (const auto& p : m_persons) {
+                        const auto poolId = p.pool_ids[typ];
+                        if (poolId + 2U > begin.size()) {
+                                begin.resize(poolId + 2U, 0U);
+                        }
+                        if (poolId > 0U) {
+                                ++begin[poolId + 1U];
+                        }
+                }
+                partial_sum(begin.begin(), begin.end(), begin.begin());
+
+                auto& members = m_members[typ];
+                members.resize(begin.back());
+                vector<uint64_t> next(begin.begin(), begin.end() - 1);
+                for (unsigned int id = 0U; id < m_persons.size(); id++) {
+                        const auto poolId = m_persons[id].pool_ids[typ];
+                        if (poolId > 0U) {
+                                members[next[poolId]++] = id;
+                        }
+                }
+        }
+}
+
+} // namespace stride
@@ -0,0 +1,99 @@
+/*
+ *  This is free software: you can redistribute it and/or modify it
+ *  under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  any later version.
+ *  The software is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *  You should have received a copy of the GNU General Public License
+ *  along with the software. If not, see <http://www.gnu.org/licenses/>.
+ *
+ *  Copyright 2020, Willem L, Kuylen E, Broeckhove J
+ */
+
+/**
+ * @file
+ * Header for the PopTopology class.
+ */
+
+#pragma once
+
+#include "contact/ContactType.h"
+#include "contact/IdSubscriptArray.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace stride {
+
+/// The part of a person that no run changes: the age and the ids of its contact pools
+/// (0 for no pool of the type).
+struct PersonTopology
+{
+        /// No age and pools.
+        PersonTopology() : age(0U), pool_ids() {}
+
+        /// The given age and pools.
+        PersonTopology(std::uint8_t a, const ContactType::IdSubscriptArray<unsigned int>& poolIds)
+            : age(a), pool_ids(poolIds)
+        {
+        }
+
+        std::uint8_t                                age;      ///< The age (in years).
+        ContactType::IdSubscriptArray<unsigned int> pool_ids; ///< The pool of each of the types.
+};
+
+/**
+ * The structure of a population as built (see PopBuilder), which no run changes: the age and
+ * pools of each person, by id, and the members of each pool, in order of id. The populations
+ * of the runs (see Population) share it read-only; each has the state of its persons (health,
+ * presence, isolation, non-compliance, tracing) and the order of the members of its pools
+ * (partitions by health) of its own, so that a run costs only that state.
+ */
+class PopTopology
+{
+public:
+        /// No persons (and of each type only the unused pool 0).
+        PopTopology() : m_persons(), m_begin(std::vector<std::uint64_t>{0U, 0U}), m_members() {}
+
+        /// The number of persons.
+        std::size_t size() const { return m_persons.size(); }
+
+        /// The person with the given id.
+        const PersonTopology& operator[](std::size_t id) const { return m_persons[id]; }
+
+        /// The number of pools of the type, including the unused pool 0.
+        std::size_t GetNumPools(ContactType::Id typ) const { return m_begin[typ].size() - 1U; }
+
+        /// The number of members of the pool.
+        std::size_t GetNumMembers(ContactType::Id typ, std::size_t poolId) const
+        {
+                return m_begin[typ][poolId + 1U] - m_begin[typ][poolId];
+        }
+
+        /// The members (ids, in increasing order) of the pool.
+        const unsigned int* GetMembers(ContactType::Id typ, std::size_t poolId) const
+        {
+                return m_members[typ].data() + m_begin[typ][poolId];
+        }
+
+private:
+        /// Fill the members of the pools from the pool ids of the persons (the types in parallel).
+        void MakePools(unsigned int numThreads);
+
+        /// Builds the persons and pools.
+        friend class PopBuilder;
+
+        /// Saves and loads the persons and pools.
+        friend class PopSnapshot;
+
+private:
+        std::vector<PersonTopology>                               m_persons; ///< The persons, by id.
+        ContactType::IdSubscriptArray<std::vector<std::uint64_t>> m_begin;   ///< Offsets of the members of each pool.
+        ContactType::IdSubscriptArray<std::vector<unsigned int>>  m_members; ///< The members of the pools.
+};
+
+} // namespace stride
@@ -30,6 +30,8 @@
 #include "util/StringUtils.h"
 
 #include <boost/property_tree/ptree.hpp>
+#include <algorithm>
+#include <omp.h>
 #include <utility>
 #include "PopBuilder.h"
 
@@ -40,7 +42,20 @@ using namespace stride::ContactType;
 
 namespace stride {
 
-Population::Population() : m_pool_sys(), m_event_logger() {}
+namespace {
+
+/// Number of days covered by the disease progression schedule: a transition is at most
+/// 255 days after the start of an infection (see Health).
+constexpr size_t PROGRESSION_DAYS = 256U;
+
+} // namespace
+
+Population::Population()
+    : m_topology(make_shared<PopTopology>()), m_pool_sys(), m_event_logger(), m_event_log(), m_health_transitions(1), m_progression(PROGRESSION_DAYS),
+      m_symptomatic(), m_onsets(PROGRESSION_DAYS), m_status_counts(1), m_infection_buffer(), m_contact_registers(),
+      m_num_threads(1U)
+{
+}
 
 std::shared_ptr<Population> Population::Create(const boost::property_tree::ptree& config,
                                                std::shared_ptr<spdlog::logger> strideLogger)
@@ -53,16 +68,7 @@ std::shared_ptr<Population> Population::Create(const boost::property_tree::ptree
         // Create empty population & and give it a InfectorLogger.
         // --------------------------------------------------------------
         const auto pop = Create();
-        if (config.get<bool>("run.event_output_file", true)) {
-                const auto prefix       = config.get<string>("run.output_prefix");
-                const auto logPath      = FileSys::BuildPath(prefix, "event_log.txt");
-                pop->RefEventLogger()   = LogUtils::CreateRotatingLogger("event_logger", logPath.string());
-                pop->RefEventLogger()->set_pattern("%v");
-                strideLogger->info("Event logging requested; logger set up.");
-        } else {
-                pop->RefEventLogger() = LogUtils::CreateNullLogger("event_logger");
-                strideLogger->info("No Event logging requested.");
-        }
+        pop->SetupEventLog(config, strideLogger);
 
         // -----------------------------------------------------------------------------------------
         // Build population.
@@ -76,6 +82,19 @@ std::shared_ptr<Population> Population::Create(const boost::property_tree::ptree
         return pop;
 }
 
+std::shared_ptr<Population> Population::Create(const boost::property_tree::ptree& config, const Population& source,
+                                               std::shared_ptr<spdlog::logger> strideLogger)
+{
+        if (!strideLogger) {
+                strideLogger = LogUtils::CreateNullLogger("Population_logger");
+        }
+        const auto pop = Create();
+        pop->SetupEventLog(config, strideLogger);
+        strideLogger->info("Sharing the topology of the population of {} persons.", source.size());
+        PopBuilder(config, strideLogger).Share(source, pop);
+        return pop;
+}
+
 std::shared_ptr<Population> Population::Create()
 {
 
@@ -89,64 +108,241 @@ std::shared_ptr<Population> Population::Create()
         return r;
 }
 
-Person* Population::CreatePerson(unsigned int id, double age, unsigned int householdId, unsigned int k12SchoolId,
-                                 unsigned int college, unsigned int workId, unsigned int primaryCommunityId,
-                                 unsigned int secondaryCommunityId, unsigned int householdClusterId, unsigned int collectivityId)
+void Population::SetupEventLog(const boost::property_tree::ptree& config, const shared_ptr<spdlog::logger>& strideLogger)
 {
-        return emplace_back(id, age, householdId, k12SchoolId, college, workId, primaryCommunityId,
-                            secondaryCommunityId, householdClusterId, collectivityId);
+        const auto format = config.get<string>("run.event_log_format", "Text");
+        if (format != "Text" && format != "Binary") {
+                throw runtime_error("Population::SetupEventLog> Invalid event_log_format: " + format);
+        }
+        if (config.get<bool>("run.event_output_file", true)) {
+                const auto prefix = config.get<string>("run.output_prefix");
+                const auto logPath = FileSys::BuildPath(prefix, "event_log.txt");
+                m_event_logger     = LogUtils::CreateRotatingLogger("event_logger", logPath.string());
+                m_event_logger->set_pattern("%v");
+                // events of the contact phase, tracing and testing go to a binary file when requested
+                if (format == "Binary") {
+                        m_event_log.OpenBinary(FileSys::BuildPath(prefix, "event_log.bin").string());
+                } else {
+                        m_event_log.OpenText(m_event_logger);
+                }
+                strideLogger->info("Event logging requested; logger set up.");
+        } else {
+                m_event_logger = LogUtils::CreateNullLogger("event_logger");
+                strideLogger->info("No Event logging requested.");
+        }
+
+        // Contacts that count for tracing: those in the given number of days before (0: all).
+        m_contact_registers.SetLookbackDays(config.get<unsigned int>("run.tracing_lookback_days", 0U));
 }
 
-unsigned int Population::GetTotalInfected() const
+void Population::Reset(const boost::property_tree::ptree& config, std::shared_ptr<spdlog::logger> strideLogger)
 {
-        unsigned int total{0U};
-        for (const auto& p : *this) {
-                const auto& h = p.GetHealth();
-                total += h.IsInfected() || h.IsRecovered();
+        if (!strideLogger) {
+                strideLogger = LogUtils::CreateNullLogger("Population_logger");
         }
-        return total;
+
+        // --------------------------------------------------------------
+        // Persons as built: only the id and the topology are kept.
+        // --------------------------------------------------------------
+        for (auto& p : *this) {
+                p = Person(p.GetId(), &(*m_topology)[p.GetId()]);
+        }
+
+        // --------------------------------------------------------------
+        // Pools with the members as added, empty worklists, no disease
+        // progression, counts or contact registers.
+        // --------------------------------------------------------------
+        for (Id typ : IdList) {
+                for (auto& pool : m_pool_sys.RefPools(typ)) {
+                        pool.ResetMembers();
+                }
+                m_pool_sys.m_active[typ].clear();
+        }
+        for (auto& log : m_health_transitions) {
+                log.clear();
+        }
+        for (auto& day : m_progression) {
+                day.clear();
+        }
+        for (auto& day : m_onsets) {
+                day.clear();
+        }
+        m_symptomatic.clear();
+        for (auto& c : m_status_counts) {
+                c.counts.fill(0);
+        }
+        m_contact_registers = ContactRegisters();
+
+        // --------------------------------------------------------------
+        // Event log of the new run (the previous one has been closed).
+        // --------------------------------------------------------------
+        m_event_log.Close();
+        SetupEventLog(config, strideLogger);
 }
 
-unsigned int Population::CountInfectedCases() const
+void Population::RegisterHealthTransition(Person* p, HealthStatus from)
 {
-        unsigned int total{0U};
-        for (const auto& p : *this) {
-                const auto& h = p.GetHealth();
-                total += h.IsInfected();
+        const auto thread = static_cast<size_t>(omp_get_thread_num());
+        m_health_transitions[thread].emplace_back(p);
+        m_status_counts[thread].counts[static_cast<size_t>(from)]--;
+        m_status_counts[thread].counts[static_cast<size_t>(p->GetHealth().GetStatus())]++;
+        if (p->GetHealth().IsExposed()) {
+                m_onsets[p->GetHealth().GetFirstDay() % PROGRESSION_DAYS].emplace_back(p);
+                unsigned short int days[4];
+                const auto         num_days = p->GetHealth().GetTransitionDays(days);
+                for (unsigned int i = 0U; i < num_days; i++) {
+                        m_progression[days[i] % PROGRESSION_DAYS].emplace_back(p);
+                }
         }
-        return total;
 }
 
-unsigned int Population::CountExposedCases() const
+void Population::StartInfection(Person* p, unsigned int idIndexCase, unsigned int idInfector,
+                                double relInfectiousness, unsigned short int firstDay, bool stopInfection)
 {
-        unsigned int total{0U};
-        for (const auto& p : *this) {
-                const auto& h = p.GetHealth();
-                total += h.IsExposed();
+        const auto from = p->GetHealth().GetStatus();
+        p->GetHealth().StartInfection(idIndexCase, idInfector, relInfectiousness, firstDay);
+        if (stopInfection) {
+                p->GetHealth().StopInfection();
         }
-        return total;
+        RegisterHealthTransition(p, from);
 }
 
-unsigned int Population::CountInfectiousCases() const
+void Population::SetImmune(Person* p)
 {
-        unsigned int total{0U};
-        for (const auto& p : *this) {
-                const auto& h = p.GetHealth();
-                total += h.IsInfectious();
+        const auto from = p->GetHealth().GetStatus();
+        p->GetHealth().SetImmune();
+        RegisterHealthTransition(p, from);
+}
+
+const vector<Person*>& Population::CRefOnsets(unsigned short int simDay) const
+{
+        return m_onsets[simDay % PROGRESSION_DAYS];
+}
+
+void Population::UpdateHealth(unsigned short int simDay)
+{
+        // The onsets of today are complete (yesterday's infections and today's imports).
+        const auto byId = [](const Person* p1, const Person* p2) { return p1->GetId() < p2->GetId(); };
+        m_onsets[(simDay + PROGRESSION_DAYS - 1U) % PROGRESSION_DAYS].clear();
+        auto& onsets = m_onsets[simDay % PROGRESSION_DAYS];
+        sort(onsets.begin(), onsets.end(), byId);
+
+        // In order of id, so the transitions are registered (and the pool members moved) as in a sweep.
+        auto& persons = m_progression[simDay % PROGRESSION_DAYS];
+        sort(persons.begin(), persons.end(), byId);
+        const auto   num_persons = static_cast<long>(persons.size());
+        vector<char> was_symptomatic(persons.size());
+#pragma omp parallel for num_threads(m_num_threads) schedule(static)
+        for (long i = 0; i < num_persons; i++) {
+                const auto p      = persons[static_cast<size_t>(i)];
+                const auto status = p->GetHealth().GetStatus();
+                was_symptomatic[static_cast<size_t>(i)] = p->GetHealth().IsSymptomatic();
+                p->GetHealth().Update(simDay);
+                if (status != p->GetHealth().GetStatus()) {
+                        RegisterHealthTransition(p, status);
+                }
         }
-        return total;
+
+        // Symptoms only start or end on a transition: drop the persons whose symptoms ended, merge
+        // the persons whose symptoms started (both in order of id).
+        const auto ended = [](const Person* p) { return !p->GetHealth().IsSymptomatic(); };
+        m_symptomatic.erase(remove_if(m_symptomatic.begin(), m_symptomatic.end(), ended), m_symptomatic.end());
+        const auto num_symptomatic = m_symptomatic.size();
+        for (size_t i = 0; i < persons.size(); i++) {
+                if (!was_symptomatic[i] && persons[i]->GetHealth().IsSymptomatic()) {
+                        m_symptomatic.emplace_back(persons[i]);
+                }
+        }
+        inplace_merge(m_symptomatic.begin(), m_symptomatic.begin() + static_cast<long>(num_symptomatic),
+                      m_symptomatic.end(), byId);
+
+        // The contact register is no longer traced once the person has recovered.
+        for (const auto p : persons) {
+                if (!p->GetHealth().IsInfected()) {
+                        m_contact_registers.Release(*p);
+                }
+        }
+        persons.clear();
 }
 
-unsigned int Population::CountSymptomaticCases() const
+void Population::UpdateContactPools()
+{
+        for (auto& log : m_health_transitions) {
+                for (const auto p : log) {
+                        for (Id typ : IdList) {
+                                const auto poolId = p->GetPoolId(typ);
+                                if (poolId > 0) {
+                                        m_pool_sys.RefPools(typ)[poolId].UpdateMember(p);
+                                        m_pool_sys.ActivatePool(typ, poolId);
+                                }
+                        }
+                }
+                log.clear();
+        }
+}
+
+void Population::SortContactPools()
+{
+        for (Id typ : IdList) {
+                auto& pools = m_pool_sys.RefPools(typ);
+                for (size_t i = 1; i < pools.size(); i++) {
+                        pools[i].SortMembers();
+                        m_pool_sys.ActivatePool(typ, static_cast<unsigned int>(i));
+                }
+        }
+        for (auto& log : m_health_transitions) {
+                log.clear();
+        }
+        m_pool_sys.UpdateActivePools();
+}
+
+unsigned int Population::CountHealthStatus(initializer_list<HealthStatus> states) const
+{
+        long long total{0};
+        for (const auto& counts : m_status_counts) {
+                for (const auto state : states) {
+                        total += counts.counts[static_cast<size_t>(state)];
+                }
+        }
+        return static_cast<unsigned int>(total);
+}
+
+unsigned int Population::ScanHealthStatus(initializer_list<HealthStatus> states) const
 {
         unsigned int total{0U};
         for (const auto& p : *this) {
-                const auto& h = p.GetHealth();
-                total += h.IsSymptomatic();
+                const auto status = p.GetHealth().GetStatus();
+                for (const auto state : states) {
+                        total += (status == state);
+                }
         }
         return total;
 }
 
+unsigned int Population::GetTotalInfected() const
+{
+        return CountHealthStatus({HealthStatus::Exposed, HealthStatus::Infectious, HealthStatus::Symptomatic,
+                                  HealthStatus::InfectiousAndSymptomatic, HealthStatus::Recovered});
+}
+
+unsigned int Population::CountInfectedCases() const
+{
+        return CountHealthStatus({HealthStatus::Exposed, HealthStatus::Infectious, HealthStatus::Symptomatic,
+                                  HealthStatus::InfectiousAndSymptomatic});
+}
+
+unsigned int Population::CountExposedCases() const { return CountHealthStatus({HealthStatus::Exposed}); }
+
+unsigned int Population::CountInfectiousCases() const
+{
+        return CountHealthStatus({HealthStatus::Infectious, HealthStatus::InfectiousAndSymptomatic});
+}
+
+unsigned int Population::CountSymptomaticCases() const
+{
+        return CountHealthStatus({HealthStatus::Symptomatic, HealthStatus::InfectiousAndSymptomatic});
+}
+
 unsigned int Population::GetMaxAge() const
 {
         unsigned int maxAge{0U};
@@ -23,12 +23,19 @@
 #include "contact/ContactPool.h"
 #include "contact/ContactPoolSys.h"
 #include "contact/ContactType.h"
+#include "contact/InfectionBuffer.h"
+#include "pop/ContactRegisters.h"
+#include "pop/EventLog.h"
 #include "pop/Person.h"
+#include "pop/PopTopology.h"
 #include "util/RnMan.h"
 #include "util/SegmentedVector.h"
 
 #include <boost/property_tree/ptree_fwd.hpp>
+#include <array>
+#include <initializer_list>
 #include <memory>
+#include <vector>
 #include <spdlog/spdlog.h>
 
 namespace stride {
@@ -39,8 +46,10 @@ class RnMan;
 
 /**
  * Key Data structure: container for
- * (a) all individuals in the population
+ * (a) all individuals in the population, in their state of the run
  * (b) the ContactPoolSys which is used to loop over ContactPools of each type
+ * The age and pools of the individuals and the members of the pools are in the PopTopology,
+ * which the populations of runs of the same population file share (see Create).
  */
 class Population : public util::SegmentedVector<Person, 2048>
 {
@@ -49,15 +58,21 @@ public:
         static std::shared_ptr<Population> Create(const boost::property_tree::ptree& config,
                                                   std::shared_ptr<spdlog::logger> strideLogger = nullptr);
 
+        /// Create a Population for the configuration over the topology of one built earlier for it
+        /// (see PopBuilder::Share), for runs that need a population of their own at the same time:
+        /// only the state of the persons and the contact pools is new.
+        static std::shared_ptr<Population> Create(const boost::property_tree::ptree& config, const Population& source,
+                                                  std::shared_ptr<spdlog::logger> strideLogger = nullptr);
+
         /// Create an empty Population, used in gengeopop.
         static std::shared_ptr<Population> Create();
 
-public:
-        /// Create Person in the population.
-        Person* CreatePerson(unsigned int id, double age, unsigned int householdId, unsigned int k12SchoolId,
-                             unsigned int collegeId, unsigned int workId, unsigned int primaryCommunityId,
-                             unsigned int secondaryCommunityId, unsigned int householdClusterId, unsigned int collectivityId);
+        /// Reset the population to its state as built, for another run with the given configuration
+        /// (see SimController): the persons keep only their age and pools, the members of the pools
+        /// are back in order of id and the event log is set up anew, as in Create.
+        void Reset(const boost::property_tree::ptree& config, std::shared_ptr<spdlog::logger> strideLogger = nullptr);
 
+public:
         /// Get the cumulative number of cases.
         unsigned int GetTotalInfected() const;
 
@@ -73,29 +88,125 @@ public:
         /// Get the current number of symptomatic cases.
         unsigned int CountSymptomaticCases() const;
 
+        /// The counts above are kept up to date with the registered health transitions;
+        /// this is the number of persons with one of the given health states obtained by
+        /// scanning the population (to check the counts).
+        unsigned int ScanHealthStatus(std::initializer_list<HealthStatus> states) const;
+
         /// Get the maximum age in the population.
         unsigned int GetMaxAge() const;
 
         /// The ContactPoolSys of the simulator.
         const ContactPoolSys& CRefPoolSys() const { return m_pool_sys; }
 
+        /// The age and pools of the persons and the members of the pools (shared, read-only).
+        const PopTopology& CRefTopology() const { return *m_topology; }
+
         /// Return the InfectorLogger.
         std::shared_ptr<spdlog::logger>& RefEventLogger() { return m_event_logger; }
 
+        /// Return the log for the events in the contact phase, tracing and testing.
+        EventLog& RefEventLog() { return m_event_log; }
+
         /// Reference the ContactPoolSys of the Population.
         ContactPoolSys& RefPoolSys() { return m_pool_sys; }
 
+        /// The contact registers of the tracing index cases.
+        const ContactRegisters& CRefContactRegisters() const { return m_contact_registers; }
+
+        /// Reference the contact registers of the tracing index cases.
+        ContactRegisters& RefContactRegisters() { return m_contact_registers; }
+
         /// Get the ContactPool size of a given type and id
         unsigned int GetPoolSize(ContactType::Id typeId, const Person* p) const;
 
+        /// Set up one health transition log for each of the given number of (OpenMP) threads.
+        void SetNumThreads(unsigned int numThreads)
+        {
+                m_num_threads = numThreads;
+                m_health_transitions.resize(numThreads);
+                m_status_counts.resize(numThreads);
+                m_infection_buffer.SetNumThreads(numThreads);
+                m_event_log.SetNumThreads(numThreads);
+        }
+
+        /// Reference the infections proposed in the contact phase.
+        InfectionBuffer& RefInfectionBuffer() { return m_infection_buffer; }
+
+        /// Start the infection of the person (see Health::StartInfection) and register the
+        /// transition. With stopInfection (track_index_case), the person recovers at once: a
+        /// case that infects no one. Infections are only started outside of parallel regions.
+        void StartInfection(Person* p, unsigned int idIndexCase, unsigned int idInfector, double relInfectiousness,
+                            unsigned short int firstDay, bool stopInfection = false);
+
+        /// Make the (susceptible) person immune and register the transition.
+        void SetImmune(Person* p);
+
+        /// Update the disease status of the persons that have a transition on the given day,
+        /// registering the changes in health status, keeping track of the symptomatic persons
+        /// and releasing the contact registers of the persons that recovered.
+        void UpdateHealth(unsigned short int simDay);
+
+        /// The persons that are symptomatic, in order of id.
+        const std::vector<Person*>& CRefSymptomatic() const { return m_symptomatic; }
+
+        /// The persons whose disease starts on the given day (disease counter 1), in order of id.
+        /// Available from the health update of that day (see UpdateHealth) up to the next one.
+        const std::vector<Person*>& CRefOnsets(unsigned short int simDay) const;
+
+        /// Apply the registered health transitions to the contact pools and clear the logs.
+        void UpdateContactPools();
+
+        /// Partition the members of all contact pools w.r.t. health status and clear the logs.
+        void SortContactPools();
+
+
+private:
+        /// Change in the number of persons per health status by the transitions that one thread
+        /// registered, padded to avoid false sharing.
+        struct alignas(64) StatusCounts
+        {
+                StatusCounts() : counts() { counts.fill(0); }
+
+                std::array<long long, 7> counts; ///< Change per HealthStatus.
+        };
 
 private:
         /// Non-trivial default constructor.
         Population();
 
+        /// Saves and restores the disease progression and the contact registers.
+        friend class SimCheckpoint;
+
+        /// Builds (or shares) the topology and the persons and pools over it.
+        friend class PopBuilder;
+
+        /// Set up the event log and the tracing lookback of the configuration.
+        void SetupEventLog(const boost::property_tree::ptree& config, const std::shared_ptr<spdlog::logger>& strideLogger);
+
+        /// Register a change in health status (from the given status) that may move the person
+        /// to another partition of its contact pools (see ContactPool). Each thread registers
+        /// in its own log and keeps its own change in the number of persons per health status.
+        /// A new infection also schedules the days on which its status may change (see
+        /// UpdateHealth). All changes in health status go through here.
+        void RegisterHealthTransition(Person* p, HealthStatus from);
+
+        /// Number of persons with one of the given health states (other than Susceptible).
+        unsigned int CountHealthStatus(std::initializer_list<HealthStatus> states) const;
+
 private:
+        std::shared_ptr<const PopTopology> m_topology;    ///< Age and pools of the persons, shared.
         ContactPoolSys                  m_pool_sys;       ///< The global @ContactPoolSys.
         std::shared_ptr<spdlog::logger> m_event_logger; ///< Logger for contact/transmission/tracing/...
+        EventLog                        m_event_log;    ///< Contact/transmission/tracing/testing events.
+        std::vector<std::vector<Person*>> m_health_transitions; ///< Health transition log per thread.
+        std::vector<std::vector<Person*>> m_progression;  ///< Persons with a disease transition, per day modulo size.
+        std::vector<Person*>            m_symptomatic;  ///< Symptomatic persons, in order of id.
+        std::vector<std::vector<Person*>> m_onsets;     ///< Persons per first day of the disease, modulo size.
+        std::vector<StatusCounts>       m_status_counts; ///< Change in the number of persons per health status, per thread.
+        InfectionBuffer                 m_infection_buffer; ///< Proposed infections, committed after the contact phase.
+        ContactRegisters                m_contact_registers; ///< Contact registers of the tracing index cases.
+        unsigned int                    m_num_threads;  ///< Number of (OpenMP) threads.
 };
 
 } // namespace stride
@@ -0,0 +1,106 @@
+/*
+ *  This is free software: you can redistribute it and/or modify it
+ *  under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  any later version.
+ *  The software is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *  You should have received a copy of the GNU General Public License
+ *  along with the software. If not, see <http://www.gnu.org/licenses/>.
+ *
+ *  Copyright 2020, Willem L, Kuylen E, Broeckhove J
+ */
+
+/**
+ * @file
+ * Implementation of the ContactScheduler class.
+ */
+
+#include "ContactScheduler.h"
+
+#include "contact/ContactPool.h"
+#include "contact/ContactPoolSys.h"
+
+#include <algorithm>
+
+namespace stride {
+
+using namespace std;
+using namespace stride::ContactType;
+using namespace stride::util;
+
+ContactScheduler::ContactScheduler(unsigned int numThreads)
+    : m_pools(numThreads), m_busy(numThreads, Stopwatch<>("busy_clock")),
+      m_idle(numThreads, Stopwatch<>("idle_clock")), m_costs()
+{
+}
+
+double ContactScheduler::GetCost(const ContactPool& pool)
+{
+        const auto size = static_cast<double>(pool.size());
+        // infectious members are matched with susceptible members, on top of loading the members
+        return static_cast<double>(pool.GetInfectiousCount()) * pool.GetSusceptibleCount() + size;
+}
+
+void ContactScheduler::Schedule(const vector<Id>& types, const ContactPoolSys& poolSys, bool activeOnly)
+{
+        const auto numThreads = m_pools.size();
+        double     total      = 0.0;
+
+        m_costs.clear();
+        for (const auto type : types) {
+                const auto& pools = poolSys.CRefPools(type);
+                const auto  add   = [this, &pools, &total, type](unsigned int poolId) {
+                        const double cost = GetCost(pools[poolId]);
+                        m_costs.emplace_back(cost, PoolKey(type, poolId));
+                        total += cost;
+                };
+                if (activeOnly) {
+                        for (const auto poolId : poolSys.CRefActivePools(type)) {
+                                add(poolId);
+                        }
+                } else {
+                        // skip pools with id = 0, because it means Not Applicable
+                        for (unsigned int poolId = 1; poolId < pools.size(); poolId++) {
+                                add(poolId);
+                        }
+                }
+        }
+        for (auto& threadPools : m_pools) {
+                threadPools.clear();
+        }
+
+        // pools with more than a small fraction of the work of a thread go largest first to the least loaded thread
+        const double threshold = total / (static_cast<double>(numThreads) * 64.0);
+        const auto   small     = stable_partition(m_costs.begin(), m_costs.end(),
+                                            [threshold](const pair<double, PoolKey>& c) { return c.first >= threshold; });
+        sort(m_costs.begin(), small, [](const pair<double, PoolKey>& a, const pair<double, PoolKey>& b) {
+                return a.first > b.first || (a.first == b.first && a.second < b.second);
+        });
+        vector<double> loads(numThreads, 0.0);
+        for (auto it = m_costs.begin(); it != small; ++it) {
+                const auto thread = static_cast<size_t>(min_element(loads.begin(), loads.end()) - loads.begin());
+                m_pools[thread].emplace_back(it->second);
+                loads[thread] += it->first;
+        }
+
+        // the small pools fill up the threads to an equal share of the work, in contiguous runs of pools
+        const double share  = total / static_cast<double>(numThreads);
+        size_t       thread = 0;
+        for (auto it = small; it != m_costs.end(); ++it) {
+                while (thread + 1 < numThreads && loads[thread] >= share) {
+                        thread++;
+                }
+                m_pools[thread].emplace_back(it->second);
+                loads[thread] += it->first;
+        }
+
+        // the order within a thread does not affect the balance: visit the pools in memory order
+        for (auto& threadPools : m_pools) {
+                sort(threadPools.begin(), threadPools.end());
+        }
+}
+
+} // namespace stride
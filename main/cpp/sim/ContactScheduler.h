@@ -0,0 +1,90 @@
+/*
+ *  This is free software: you can redistribute it and/or modify it
+ *  under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  any later version.
+ *  The software is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *  You should have received a copy of the GNU General Public License
+ *  along with the software. If not, see <http://www.gnu.org/licenses/>.
+ *
+ *  Copyright 2020, Willem L, Kuylen E, Broeckhove J
+ */
+
+/**
+ * @file
+ * Header for the ContactScheduler class.
+ */
+
+#pragma once
+
+#include "contact/ContactType.h"
+#include "util/Stopwatch.h"
+
+#include <utility>
+#include <vector>
+
+namespace stride {
+
+class ContactPool;
+class ContactPoolSys;
+
+/**
+ * Assigns the contact pools that the Infector visits on a day to the (OpenMP) threads.
+ * The pools of all contact types are scheduled together: the Infector only proposes
+ * infections (see InfectionBuffer), so threads need not wait for each other between types.
+ * Pool sizes are very skewed, so a static schedule over the pool index leaves threads idle.
+ * Pools with a large estimated cost are assigned largest first to the thread with the
+ * least work so far (longest-processing-time-first); the many small pools then fill up
+ * the threads in contiguous runs of pool ids. Each thread visits its pools in order of
+ * type and id. The assignment only depends on the pools, so a run remains reproducible
+ * for a given number of threads.
+ * The scheduler also accumulates the busy and idle time of each thread in the contact phase.
+ */
+class ContactScheduler
+{
+public:
+        /// Scheduler for the given number of threads.
+        explicit ContactScheduler(unsigned int numThreads = 1U);
+
+        /// Assign the pools of the given types: the pools in the worklist (activeOnly) or all pools.
+        void Schedule(const std::vector<ContactType::Id>& types, const ContactPoolSys& poolSys, bool activeOnly);
+
+        /// Type and id of the pools that are assigned to the thread, in order of processing.
+        const std::vector<std::pair<ContactType::Id, unsigned int>>& GetPools(unsigned int thread) const
+        {
+                return m_pools[thread];
+        }
+
+        /// Number of threads.
+        unsigned int GetNumThreads() const { return static_cast<unsigned int>(m_pools.size()); }
+
+        /// Clock with the time the thread spends in the Infector.
+        util::Stopwatch<>& RefBusyClock(unsigned int thread) { return m_busy[thread]; }
+
+        /// Clock with the time the thread waits for the other threads.
+        util::Stopwatch<>& RefIdleClock(unsigned int thread) { return m_idle[thread]; }
+
+        /// Time the thread spent in the Infector.
+        const util::Stopwatch<>& CRefBusyClock(unsigned int thread) const { return m_busy[thread]; }
+
+        /// Time the thread waited for the other threads.
+        const util::Stopwatch<>& CRefIdleClock(unsigned int thread) const { return m_idle[thread]; }
+
+private:
+        /// Estimated cost of the Infector in the pool (the few members with recorded contacts are ignored).
+        static double GetCost(const ContactPool& pool);
+
+private:
+        /// Type and id of a pool.
+        using PoolKey = std::pair<ContactType::Id, unsigned int>;
+
+        std::vector<std::vector<PoolKey>>        m_pools; ///< Pools per thread.
+        std::vector<util::Stopwatch<>>           m_busy;  ///< Busy time per thread.
+        std::vector<util::Stopwatch<>>           m_idle;  ///< Idle time per thread.
+        std::vector<std::pair<double, PoolKey>>  m_costs; ///< Work space: cost and pool.
+};
+
+} // namespace stride
@@ -0,0 +1,239 @@
+/*
+ *  This is free software: you can redistribute it and/or modify it
+ *  under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  any later version.
+ *  The software is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *  You should have received a copy of the GNU General Public License
+ *  along with the software. If not, see <http://www.gnu.org/licenses/>.
+ *
+ *  Copyright 2020, Willem L, Kuylen E, Broeckhove J
+ */
+
+/**
+ * @file
+ * Implementation of the IndexCaseSim class.
+ */
+
+#include "IndexCaseSim.h"
+
+#include "calendar/Calendar.h"
+#include "contact/ContactPool.h"
+#include "contact/ContactPoolView.h"
+#include "pop/Population.h"
+#include "sim/Sim.h"
+#include "util/FileSys.h"
+#include "util/Philox.h"
+#include "util/RnHandler.h"
+#include "util/StringUtils.h"
+
+#include <cstdint>
+#include <fstream>
+#include <stdexcept>
+#include <utility>
+
+namespace stride {
+
+using namespace std;
+using namespace stride::ContactType;
+using namespace stride::util;
+
+namespace {
+
+/// Member columns of the pool that is being visited, one per (OpenMP) thread.
+thread_local ContactPoolView t_pool_view;
+
+/// State of a replicate: the index case (a copy, with the infection) and its secondary cases,
+/// the only persons that differ from the population as built.
+struct Replicate
+{
+        Replicate() : index(), infected(), key(0U), result() {}
+
+        Person                     index;    ///< The index case.
+        vector<const Person*>      infected; ///< The secondary cases (recovered).
+        uint64_t                   key;      ///< Key of the counter-based random numbers.
+        IndexCaseSim::Result       result;   ///< The secondary cases per type of pool.
+};
+
+/// Key of the random numbers of the given replicate, derived from the key of the run.
+uint64_t GetReplicateKey(uint64_t runKey, unsigned int replicate)
+{
+        const auto r = Philox::Generate({{replicate, 0U, 0U, 0U}},
+                                        {{static_cast<uint32_t>(runKey), static_cast<uint32_t>(runKey >> 32U)}});
+        return (static_cast<uint64_t>(r[0]) << 32U) | r[1];
+}
+
+/// Can the person be drawn as index case?
+bool IsEligible(const Person& p, double ageMin, double ageMax)
+{
+        return p.GetHealth().IsSusceptible() && p.GetAge() >= ageMin && p.GetAge() <= ageMax;
+}
+
+/// Contacts and transmissions of the (infectious) index case in one of its pools.
+void VisitPool(Replicate& rep, const ContactPool& pool, const ContactPolicy& policy,
+               const TransmissionProfile& transProfile, RnHandler& rnHandler, unsigned short int simDay)
+{
+        const auto pType = pool.GetType();
+        const auto pSize = pool.size();
+        auto&      view  = t_pool_view;
+        view.Load(pool, pSize, policy);
+        rnHandler.SetKey(simDay, RnHandler::Purpose::Contact, static_cast<unsigned int>(pType), pool.GetId());
+
+        // the secondary cases of the replicate are not susceptible anymore
+        for (const auto p : rep.infected) {
+                if (p->GetPoolId(pType) == pool.GetId()) {
+                        view.SetStatus(p->GetPoolSlot(pType), HealthStatus::Recovered);
+                }
+        }
+
+        const auto   i_index               = rep.index.GetPoolSlot(pType);
+        const double tProb_index           = transProfile.GetInfectorProbability(&rep.index);
+        const double cnt_adjustment_factor = policy.GetAdjustmentFactor(pType, pool.GetMinAge());
+        for (size_t i_contact = view.NextPresent(0, pSize); i_contact < pSize;
+             i_contact = view.NextPresent(i_contact + 1, pSize)) {
+                if (i_contact == i_index || !view.IsSusceptible(i_contact)) {
+                        continue;
+                }
+                const double cProb = policy.GetContactProbability(view, i_index, i_contact, pSize, pType,
+                                                                  cnt_adjustment_factor);
+                const double tProb =
+                    transProfile.GetProbability(tProb_index, view.GetAge(i_contact), view.GetSusceptibility(i_contact));
+                if (rnHandler.Binomial(cProb, tProb)) {
+                        rep.infected.emplace_back(pool[i_contact]);
+                        rep.result.secondary_cases[pType]++;
+                        view.SetStatus(i_contact, HealthStatus::Recovered);
+                }
+        }
+}
+
+} // namespace
+
+unsigned int IndexCaseSim::Result::GetSecondaryCases() const
+{
+        unsigned int count = 0U;
+        for (auto typ : IdList) {
+                count += secondary_cases[typ];
+        }
+        return count;
+}
+
+IndexCaseSim::IndexCaseSim(shared_ptr<Sim> sim) : m_sim(std::move(sim)) {}
+
+vector<IndexCaseSim::Result> IndexCaseSim::Run(unsigned int numIndexCases)
+{
+        Sim&        sim          = *m_sim;
+        const auto& population   = *sim.m_population;
+        const auto& poolSys      = population.CRefPoolSys();
+        const auto& policy       = sim.m_contact_policy;
+        const auto& transProfile = sim.m_transmission_profile;
+        const auto  numDays      = sim.m_config.get<unsigned int>("run.num_days");
+        const auto  ageMin       = sim.m_config.get<double>("run.seeding_age_min", 1);
+        const auto  ageMax       = sim.m_config.get<double>("run.seeding_age_max", 99);
+        const auto  runKey       = sim.m_rn_man.GetCounterKey();
+
+        size_t numEligible = 0U;
+        for (const auto& p : population) {
+                numEligible += IsEligible(p, ageMin, ageMax) ? 1U : 0U;
+        }
+        if (numIndexCases > 0U && numEligible == 0U) {
+                throw runtime_error("IndexCaseSim::Run> No susceptible persons within the seeding ages.");
+        }
+
+        // --------------------------------------------------------------
+        // Draw the index cases and start their infections.
+        // --------------------------------------------------------------
+        vector<Replicate> replicates(numIndexCases);
+#pragma omp parallel for schedule(static) num_threads(sim.m_num_threads)
+        for (unsigned int r = 0U; r < numIndexCases; r++) {
+                auto& rep = replicates[r];
+                rep.key   = GetReplicateKey(runKey, r);
+                RnHandler rnHandler(rep.key, 0U, true);
+                rnHandler.SetKey(0U, RnHandler::Purpose::DiseaseSeeding, 0U, 0U);
+                const Person* p = nullptr;
+                do {
+                        p = &population[static_cast<size_t>(rnHandler() * static_cast<double>(population.size()))];
+                } while (!IsEligible(*p, ageMin, ageMax));
+                rep.index = *p;
+                rep.index.GetHealth().StartInfection(p->GetId(), 0U, transProfile.GetIndividualInfectiousness(rnHandler),
+                                                     0U);
+                rep.result.id  = p->GetId();
+                rep.result.age = static_cast<unsigned int>(p->GetAge());
+        }
+
+        // --------------------------------------------------------------
+        // Step the replicates with an infected index case, day by day.
+        // --------------------------------------------------------------
+        auto& calendar    = *sim.m_calendar;
+        auto  numInfected = numIndexCases;
+        for (unsigned int day = 0U; day < numDays && numInfected > 0U; day++) {
+                sim.UpdateContactPolicy();
+                const auto simDay = calendar.GetSimulationDay();
+                const auto types  = sim.GetContactTypes();
+                numInfected       = 0U;
+
+#pragma omp parallel for schedule(dynamic, 16) num_threads(sim.m_num_threads) reduction(+ : numInfected)
+                for (unsigned int r = 0U; r < numIndexCases; r++) {
+                        auto& rep    = replicates[r];
+                        auto& health = rep.index.GetHealth();
+                        if (!health.IsInfected()) {
+                                continue;
+                        }
+                        health.Update(simDay);
+                        numInfected += health.IsInfected() ? 1U : 0U;
+
+                        RnHandler rnHandler(rep.key, 0U, true);
+                        if (health.IsSymptomatic()) {
+                                rnHandler.SetKey(simDay, RnHandler::Purpose::Update, 0U, rep.index.GetId());
+                                rep.index.DrawAbsences(rnHandler);
+                        }
+                        if (!health.IsInfectious()) {
+                                continue;
+                        }
+                        for (const auto typ : types) {
+                                const auto poolId = rep.index.GetPoolId(typ);
+                                if (poolId == 0U) {
+                                        continue;
+                                }
+                                const auto& pool = poolSys.CRefPools(typ)[poolId];
+                                if (policy.IsPresent(rep.index, typ, pool.GetMinAge())) {
+                                        VisitPool(rep, pool, policy, transProfile, rnHandler, simDay);
+                                }
+                        }
+                }
+                calendar.AdvanceDay();
+        }
+
+        vector<Result> results;
+        results.reserve(replicates.size());
+        for (const auto& rep : replicates) {
+                results.emplace_back(rep.result);
+        }
+        return results;
+}
+
+void IndexCaseSim::WriteResults(const string& outputPrefix, const vector<Result>& results)
+{
+        const auto    path = FileSys::BuildPath(outputPrefix, "index_cases.csv");
+        std::ofstream file(path.string());
+        if (!file.is_open()) {
+                throw runtime_error("IndexCaseSim::WriteResults> Error opening file: " + path.string());
+        }
+
+        file << "id,age,secondary_cases";
+        for (auto typ : IdList) {
+                file << "," << ToLower(ContactType::ToString(typ));
+        }
+        file << endl;
+        for (const auto& result : results) {
+                file << result.id << "," << result.age << "," << result.GetSecondaryCases();
+                for (auto typ : IdList) {
+                        file << "," << result.secondary_cases[typ];
+                }
+                file << "\n";
+        }
+}
+
+} // namespace stride
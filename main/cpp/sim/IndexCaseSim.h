@@ -0,0 +1,84 @@
+/*
+ *  This is free software: you can redistribute it and/or modify it
+ *  under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  any later version.
+ *  The software is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *  You should have received a copy of the GNU General Public License
+ *  along with the software. If not, see <http://www.gnu.org/licenses/>.
+ *
+ *  Copyright 2020, Willem L, Kuylen E, Broeckhove J
+ */
+
+/**
+ * @file
+ * Header for the IndexCaseSim class.
+ */
+
+#pragma once
+
+#include "contact/ContactType.h"
+#include "contact/IdSubscriptArray.h"
+
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace stride {
+
+class Sim;
+
+/**
+ * Secondary cases of index cases (track_index_case runs, e.g. to estimate R0) without
+ * time stepping the whole population. With track_index_case, the secondary cases do not
+ * infect anyone, so only the index case and the members of its contact pools matter.
+ *
+ * The index cases are independent replicates over the population of the simulator, which
+ * is only read and stays as built (without infected seeds). Each replicate keeps a copy of
+ * its index case (with the infection and today's absences) and the secondary cases it has
+ * made (recovered, as with track_index_case). Day by day, the replicates (in parallel with
+ * the threads of the simulator) visit the pools of their index case while it is infectious,
+ * with the contact and transmission probabilities of the Infector. Calendar, distancing and
+ * school closures apply, public health measures (contact tracing, universal testing) and
+ * imported cases do not. The index cases are drawn as the DiseaseSeeder draws infected seeds.
+ *
+ * Each replicate draws its random numbers from a counter-based generator of its own, keyed
+ * by the seed of the simulator and the number of the replicate, so the results do not depend
+ * on the number of threads (with rng_type Counter; otherwise the health seeding of the
+ * population does).
+ */
+class IndexCaseSim
+{
+public:
+        /// The index case of a replicate and its secondary cases per type of contact pool.
+        struct Result
+        {
+                /// No secondary cases.
+                Result() : id(0U), age(0U), secondary_cases() {}
+
+                unsigned int                                id;              ///< Id of the index case.
+                unsigned int                                age;             ///< Age of the index case.
+                ContactType::IdSubscriptArray<unsigned int> secondary_cases; ///< Secondary cases per pool type.
+
+                /// The number of secondary cases.
+                unsigned int GetSecondaryCases() const;
+        };
+
+public:
+        /// For the simulator (built, not run), its population built without infected seeds.
+        explicit IndexCaseSim(std::shared_ptr<Sim> sim);
+
+        /// Simulate the given number of index cases for (at most) the number of days of the run.
+        std::vector<Result> Run(unsigned int numIndexCases);
+
+        /// Write the results to index_cases.csv in the output prefix.
+        static void WriteResults(const std::string& outputPrefix, const std::vector<Result>& results);
+
+private:
+        std::shared_ptr<Sim> m_sim; ///< The simulator, for its population, contact policy and calendar.
+};
+
+} // namespace stride
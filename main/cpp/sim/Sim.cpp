@@ -39,8 +39,10 @@ using namespace EventLogMode;
 
 Sim::Sim()
     : m_config(), m_event_log_mode(Id::None), m_num_threads(1U), m_track_index_case(false),
-      m_calendar(nullptr), m_contact_profiles(), m_rn_handlers(), m_infector_default(),m_infector_tracing(),
-      m_population(nullptr), m_rn_man(), m_transmission_profile(),
+      m_calendar(nullptr), m_contact_profiles(), m_contact_policy(), m_rn_handlers(), m_infector_default(),m_infector_tracing(),
+      m_commit_default(), m_commit_tracing(),
+      m_active_pools_default(false), m_active_pools_tracing(false), m_contact_scheduler(),
+      m_person_events(), m_population(nullptr), m_rn_man(), m_transmission_profile(),
 	  m_cnt_intensity_householdCluster(0),
       m_is_isolated_from_household(false),
 	  m_public_health_agency(),m_universal_testing(),m_num_daily_imported_cases(0)
@@ -49,107 +51,134 @@ Sim::Sim()
 }
 
 std::shared_ptr<Sim> Sim::Create(const boost::property_tree::ptree& config, shared_ptr<Population> pop,
-                                 util::RnMan rnMan)
+                                 util::RnMan rnMan, SimInputCache* inputCache)
 {
         struct make_shared_enabler : public Sim
         {
                 explicit make_shared_enabler() : Sim() {}
         };
         shared_ptr<Sim> sim = make_shared<make_shared_enabler>();
-        SimBuilder(config).Build(sim, std::move(pop), std::move(rnMan));
+        SimBuilder(config, inputCache).Build(sim, std::move(pop), std::move(rnMan));
         return sim;
 }
 
-void Sim::TimeStep()
+void Sim::UpdateContactPolicy()
 {
+        // set HouseholdCluster intensity
+        double cnt_intensity_householdCluster = 0.0;
+        if (m_calendar->IsHouseholdClusteringAllowed() &&
+            m_population->RefPoolSys().RefPools(ContactType::Id::HouseholdCluster).size() > 1) {
+                cnt_intensity_householdCluster = m_cnt_intensity_householdCluster;
+        }
+        m_contact_policy.Update(*m_calendar, cnt_intensity_householdCluster, m_is_isolated_from_household);
+}
 
+vector<ContactType::Id> Sim::GetContactTypes() const
+{
         // Logic where you compute (on the basis of input/config for initial day or on the basis of
         // number of sick persons, duration of epidemic etc) what kind of DaysOff scheme you apply.
-        const bool isRegularWeekday     = m_calendar->IsRegularWeekday();
-        const bool isHouseholdClusteringAllowed    = m_calendar->IsHouseholdClusteringAllowed();
+        const bool isRegularWeekday             = m_calendar->IsRegularWeekday();
+        const bool isHouseholdClusteringAllowed = m_calendar->IsHouseholdClusteringAllowed();
+
+        vector<ContactType::Id> types;
+        for (auto typ : ContactType::IdList) {
+                if ((typ == ContactType::Id::Workplace && !isRegularWeekday) ||
+                    (typ == ContactType::Id::K12School && !isRegularWeekday) ||
+                    (typ == ContactType::Id::College && !isRegularWeekday) ||
+                    (typ == ContactType::Id::HouseholdCluster && !isHouseholdClusteringAllowed)) {
+                        continue;
+                }
+                types.emplace_back(typ);
+        }
+        return types;
+}
+
+void Sim::TimeStep()
+{
 
 		// To be used in update of population & contact pools.
         Population& population    = *m_population;
         auto&       logger        = population.RefEventLogger();
         auto&       poolSys       = population.RefPoolSys();
-        auto        eventLogger   = population.RefEventLogger();
+        auto&       eventLog      = population.RefEventLog();
         const auto  simDay        = m_calendar->GetSimulationDay();
 
         // Select infector, based on tracing
-        const auto& infector      = m_public_health_agency.IsContactTracingActive(m_calendar) ? *m_infector_tracing : *m_infector_default;
+        const bool  isTracing     = m_public_health_agency.IsContactTracingActive(m_calendar);
+        const auto& infector      = isTracing ? *m_infector_tracing : *m_infector_default;
+        const auto& commit        = isTracing ? *m_commit_tracing : *m_commit_default;
+        const bool  activeOnly    = isTracing ? m_active_pools_tracing : m_active_pools_default;
 
-        // set HouseholdCluster intensity
-        double cnt_intensity_householdCluster = 0.0;
-		if (isHouseholdClusteringAllowed && poolSys.RefPools(ContactType::Id::HouseholdCluster).size() > 1){
-			cnt_intensity_householdCluster = m_cnt_intensity_householdCluster;
-		}
+        // Resolve today's contact rates (distancing & HouseholdCluster intensity) and presence
+        UpdateContactPolicy();
 
         // Import infected cases into the population
         if(m_calendar->GetNumberOfImportedCases() > 0){
+        	m_rn_handlers[0].SetKey(simDay, RnHandler::Purpose::Import, 0U, 0U);
         	DiseaseSeeder(m_config, m_rn_man).ImportInfectedCases(m_population, m_calendar->GetNumberOfImportedCases(), simDay, m_transmission_profile, m_rn_handlers[0]);
-            logger->info("[IMPORT-CASES] sim_day={} count={}", simDay, m_calendar->GetNumberOfImportedCases());        	
+            eventLog.Log(EventRecord::ImportCases(simDay, m_calendar->GetNumberOfImportedCases()));
         }
 
+        // Start and end the isolations that are scheduled for today
+        m_person_events.Execute(simDay);
+
+        // Progress the disease of the persons with a transition today
+        population.UpdateHealth(simDay);
+
+        // Draw today's absences of the symptomatic persons (presence otherwise follows from the contact policy)
+        const auto& symptomatic = population.CRefSymptomatic();
 #pragma omp parallel num_threads(m_num_threads)
         {
-        	const auto thread_num = static_cast<unsigned int>(omp_get_thread_num());
-			// Update health status and presence/absence in contact pools
-			// depending on health status, work/school day and whether
-			// we want to track index cases without adaptive behavior
+                const auto thread_num = static_cast<unsigned int>(omp_get_thread_num());
 #pragma omp for schedule(static)
-			for (size_t i = 0; i < population.size(); ++i) {
-
-				// adjust K12SchoolOff boolean to school type for individual 'i'
-//				bool isK12SchoolOff = m_public_health_agency.IsK12SchoolOff(population[i].GetAge(),
-//						m_calendar->IsSchoolClosed(0), //isPreSchoolOff,
-//						m_calendar->IsSchoolClosed(6), //isPrimarySchoolOff,
-//						m_calendar->IsSchoolClosed(11), //isSecondarySchoolOff,
-//						m_calendar->IsSchoolClosed(20)); //isCollegeOff);
-
-				unsigned int school_id = population[i].GetPoolId(ContactType::Id::K12School);
-				unsigned int school_age = population[i].GetAge();
-				if(school_id>0){
-					school_age = poolSys.RefPools(ContactType::Id::K12School)[school_id].GetMinAge();
-				}
-				bool isK12SchoolOff = m_calendar->IsSchoolClosed(school_age);
-				bool isCollegeOff   = m_calendar->IsSchoolClosed(population[i].GetAge());
-				// update health and presence at different contact pools
-				population[i].Update(isRegularWeekday, isK12SchoolOff, isCollegeOff,
-						isHouseholdClusteringAllowed,
-						m_is_isolated_from_household,
-                        m_rn_handlers[thread_num], 
-                        m_calendar);
-			}
+                for (size_t i = 0; i < symptomatic.size(); ++i) {
+                        m_rn_handlers[thread_num].SetKey(simDay, RnHandler::Purpose::Update, 0U, symptomatic[i]->GetId());
+                        symptomatic[i]->DrawAbsences(m_rn_handlers[thread_num]);
+                }
         }// end pragma openMP
 
 		 // Perform contact tracing (if activated)
-		 m_public_health_agency.PerformContactTracing(m_population, m_rn_handlers[0], m_calendar);
+		 m_rn_handlers[0].SetKey(simDay, RnHandler::Purpose::Tracing, 0U, 0U);
+		 m_public_health_agency.PerformContactTracing(m_population, m_rn_handlers, m_calendar, m_person_events);
 
 		 // Perform universal testing 
-	     m_universal_testing.PerformUniversalTesting(m_population, m_rn_handlers[0], m_calendar,m_public_health_agency);
+	     m_universal_testing.PerformUniversalTesting(m_population, m_rn_handlers, m_calendar,m_public_health_agency, m_person_events);
+
+	     // Move members with a new health status to the matching partition of their contact pools
+	     population.UpdateContactPools();
+	     poolSys.UpdateActivePools();
+
+        // Assign the pools of today's contact types to the threads
+        m_contact_scheduler.Schedule(GetContactTypes(), poolSys, activeOnly);
 
 #pragma omp parallel num_threads(m_num_threads)
         {
 		    const auto thread_num = static_cast<unsigned int>(omp_get_thread_num());
-			// Infector updates individuals for contacts & transmission within each pool.
-			// Skip pools with id = 0, because it means Not Applicable.
-			for (auto typ : ContactType::IdList) {
-					if ((typ == ContactType::Id::Workplace && !isRegularWeekday) ||
-						(typ == ContactType::Id::K12School && !isRegularWeekday) ||
-						(typ == ContactType::Id::College && !isRegularWeekday) ||
-						(typ == ContactType::Id::HouseholdCluster && !isHouseholdClusteringAllowed)) {
-							continue;
-					}
-#pragma omp for schedule(static)
-					for (size_t i = 1; i < poolSys.RefPools(typ).size(); i++) { // NOLINT
-							infector(poolSys.RefPools(typ)[i], m_contact_profiles[typ], m_transmission_profile,
-									 m_rn_handlers[thread_num], simDay, eventLogger,
-									 m_population,cnt_intensity_householdCluster,m_calendar);
-					}
+		    auto&      busyClock  = m_contact_scheduler.RefBusyClock(thread_num);
+		    auto&      idleClock  = m_contact_scheduler.RefIdleClock(thread_num);
+
+			// Infector proposes contacts & transmissions within each pool.
+			busyClock.Start();
+			for (const auto& pool : m_contact_scheduler.GetPools(thread_num)) {
+					infector(poolSys.RefPools(pool.first)[pool.second], m_contact_policy, m_transmission_profile,
+							 m_rn_handlers[thread_num], simDay, eventLog, population);
 			}
+			busyClock.Stop();
+
+			idleClock.Start();
+#pragma omp barrier
+			idleClock.Stop();
         } // end pragma openMP
 
-        m_population->RefEventLogger()->flush();
+        // Commit the proposed infections and move the new cases to the matching partition of their pools
+        commit(simDay, eventLog, population);
+        population.UpdateContactPools();
+
+        // Isolations that start today (scheduled by tracing and testing) count as of tomorrow's contacts
+        m_person_events.ExecuteSameDay();
+
+        eventLog.Flush();
+        logger->flush();
         m_calendar->AdvanceDay();
 }
 
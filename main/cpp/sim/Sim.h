@@ -21,16 +21,20 @@
 #pragma once
 
 #include "contact/AgeContactProfiles.h"
+#include "contact/ContactPolicy.h"
 #include "contact/EventLogMode.h"
 #include "contact/InfectorExec.h"
 #include "disease/PublicHealthAgency.h"
 #include "disease/TransmissionProfile.h"
 #include "disease/UniversalTesting.h"
+#include "sim/ContactScheduler.h"
+#include "sim/TimingWheel.h"
 #include "util/RnMan.h"
 #include "util/RnHandler.h"
 
 #include <boost/property_tree/ptree.hpp>
 #include <string>
+#include <vector>
 
 
 
@@ -38,6 +42,7 @@ namespace stride {
 
 class Calendar;
 class Population;
+struct SimInputCache;
 
 namespace util {
 class RnMan;
@@ -51,9 +56,10 @@ class RnHandler;
 class Sim
 {
 public:
-        /// Create Sim initialized by the configuration in property tree and population.
+        /// Create Sim initialized by the configuration in property tree and population, reading the
+        /// inputs through the cache if any (see SimBuilder).
         static std::shared_ptr<Sim> Create(const boost::property_tree::ptree& config, std::shared_ptr<Population> pop,
-                                           util::RnMan rnMan);
+                                           util::RnMan rnMan, SimInputCache* inputCache = nullptr);
 
         /// Calendar for the simulated world. Initialized with the start date in the simulation
         /// world. Use GetCalendar()->GetSimulationDay() for the number of days simulated.
@@ -74,6 +80,9 @@ public:
         /// Get the transmission profile.
         const TransmissionProfile& RefTransmissionProfile() const { return m_transmission_profile; }
 
+        /// Get the assignment of contact pools to threads, with the busy/idle time of each thread.
+        const ContactScheduler& CRefContactScheduler() const { return m_contact_scheduler; }
+
         /// Run one time step, computing full simulation (default) or only index case.
         void TimeStep();
 
@@ -81,7 +90,15 @@ private:
         /// Constructor for empty Simulator.
         explicit Sim();
 
+        /// Resolve today's contact rates (distancing & HouseholdCluster intensity) and presence.
+        void UpdateContactPolicy();
+
+        /// The types of the contact pools with contacts today (e.g. no work or school on weekends).
+        std::vector<ContactType::Id> GetContactTypes() const;
+
+        friend class IndexCaseSim;
         friend class SimBuilder;
+        friend class SimCheckpoint;
 
 private:
         boost::property_tree::ptree m_config;                        ///< Configuration property tree
@@ -91,9 +108,16 @@ private:
 
         std::shared_ptr<Calendar>   m_calendar;         ///< Management of calendar.
         AgeContactProfiles          m_contact_profiles; ///< Contact profiles w.r.t age.
+        ContactPolicy               m_contact_policy;   ///< Contact rates for the current day.
         std::vector<util::RnHandler> m_rn_handlers;     ///< Random number handlers (random numbers & binomial trials).
         InfectorExec*               m_infector_default; ///< Executes optimized transmission loops in contact pools.
         InfectorExec*               m_infector_tracing; ///< Executes all or optimized transmission loops in contact pools.
+        InfectorCommit*             m_commit_default;   ///< Commits the infections of the default infector.
+        InfectorCommit*             m_commit_tracing;   ///< Commits the infections of the tracing infector.
+        bool                        m_active_pools_default; ///< Does the default infector only need the active pools?
+        bool                        m_active_pools_tracing; ///< Does the tracing infector only need the active pools?
+        ContactScheduler            m_contact_scheduler; ///< Assigns the contact pools to the threads.
+        TimingWheel                 m_person_events;    ///< Scheduled start and end of isolations.
         std::shared_ptr<Population> m_population;       ///< Pointer to the Population.
         util::RnMan                 m_rn_man;           ///< Random number generation management.
 
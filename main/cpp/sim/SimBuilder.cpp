@@ -39,7 +39,7 @@ using namespace std;
 using namespace stride::util;
 using namespace ContactType;
 
-SimBuilder::SimBuilder(const ptree& config) : m_config(config) {}
+SimBuilder::SimBuilder(const ptree& config, SimInputCache* inputCache) : m_config(config), m_input_cache(inputCache) {}
 
 shared_ptr<Sim> SimBuilder::Build(shared_ptr<Sim> sim, shared_ptr<Population> pop, RnMan rnMan)
 {
@@ -50,28 +50,49 @@ shared_ptr<Sim> SimBuilder::Build(shared_ptr<Sim> sim, shared_ptr<Population> po
         sim->m_population                    = std::move(pop);
         sim->m_track_index_case              = m_config.get<bool>("run.track_index_case");
         sim->m_num_threads                   = m_config.get<unsigned int>("run.num_threads");
-        unsigned int num_days                = m_config.get<unsigned short>("run.num_days");
-        sim->m_calendar                      = make_shared<Calendar>(m_config,num_days);
+        sim->m_calendar                      = MakeCalendar();
         sim->m_event_log_mode                = EventLogMode::ToMode(m_config.get<string>("run.event_log_level", "None"));
         sim->m_rn_man                        = std::move(rnMan);
+        sim->m_population->SetNumThreads(sim->m_num_threads);
+        sim->m_contact_scheduler             = ContactScheduler(sim->m_num_threads);
+        sim->m_person_events                 = TimingWheel(sim->m_num_threads);
 
         // --------------------------------------------------------------
-        // Contact handlers, each with generator bound to different
-        // random engine stream) and infector.
+        // Contact handlers, each with an engine seeded from a different
+        // random engine stream, and infector.
         // --------------------------------------------------------------
         for (unsigned int i = 0; i < sim->m_num_threads; i++) {
-                auto gen = sim->m_rn_man.GetUniform01Generator(i);
-                sim->m_rn_handlers.emplace_back(util::RnHandler(gen));
+                if (sim->m_rn_man.IsCounterBased()) {
+                        sim->m_rn_handlers.emplace_back(sim->m_rn_man.GetCounterKey(), i, true);
+                } else {
+                        sim->m_rn_handlers.emplace_back(sim->m_rn_man.GetSeed(i), i);
+                }
         }
-        const auto& select = make_tuple(sim->m_event_log_mode, sim->m_track_index_case);
-        sim->m_infector_default    = InfectorMap().at(select);
+        // transmission sampling: one binomial trial per pair (default) or geometric skips
+        const auto sampling = m_config.get<string>("run.transmission_sampling", "Bernoulli");
+        if (sampling != "Bernoulli" && sampling != "Geometric") {
+                throw runtime_error("SimBuilder::Build> Invalid transmission_sampling: " + sampling);
+        }
+        const bool geometric_sampling = (sampling == "Geometric");
+
+        const auto& select = make_tuple(sim->m_event_log_mode, sim->m_track_index_case, geometric_sampling);
+        const auto  infector_default = InfectorMap().at(select);
+        sim->m_infector_default     = infector_default.first;
+        sim->m_commit_default       = infector_default.second;
+        // only the optimized infectors (no contact logging) have nothing to do in pools without infectious members
+        sim->m_active_pools_default = (sim->m_event_log_mode != EventLogMode::Id::All);
 
         // additional infector if logmode is Tracing
         if(m_config.get<string>("run.event_log_level", "None") == "ContactTracing"){
-        	const auto& select_tracing  = make_tuple(EventLogMode::Id::All, sim->m_track_index_case);
-        	sim->m_infector_tracing    = InfectorMap().at(select_tracing);
+        	const auto& select_tracing  = make_tuple(EventLogMode::Id::All, sim->m_track_index_case, geometric_sampling);
+        	const auto  infector_tracing = InfectorMap().at(select_tracing);
+        	sim->m_infector_tracing     = infector_tracing.first;
+        	sim->m_commit_tracing       = infector_tracing.second;
+        	sim->m_active_pools_tracing = false;
         } else{
-        	sim->m_infector_tracing    = InfectorMap().at(select);
+        	sim->m_infector_tracing     = sim->m_infector_default;
+        	sim->m_commit_tracing       = sim->m_commit_default;
+        	sim->m_active_pools_tracing = sim->m_active_pools_default;
         }
 
         // --------------------------------------------------------------
@@ -81,6 +102,7 @@ shared_ptr<Sim> SimBuilder::Build(shared_ptr<Sim> sim, shared_ptr<Population> po
         for (Id typ : IdList) {
                 sim->m_contact_profiles[typ] = AgeContactProfile(typ, ageContactPt);
         }
+        sim->m_contact_policy.Initialize(sim->m_contact_profiles, *sim->m_population);
 
         // --------------------------------------------------------------
         // Initialize the transmission profile (fixes rates).
@@ -102,6 +124,7 @@ shared_ptr<Sim> SimBuilder::Build(shared_ptr<Sim> sim, shared_ptr<Population> po
         // --------------------------------------------------------------
         // Seed population with infection.
         // --------------------------------------------------------------
+        sim->m_rn_handlers[0].SetKey(0U, util::RnHandler::Purpose::DiseaseSeeding, 0U, 0U);
         DiseaseSeeder(m_config, sim->m_rn_man).Seed(sim->m_population, sim->m_transmission_profile, sim->m_rn_handlers[0]);
         sim->m_num_daily_imported_cases = m_config.get<double>("run.num_daily_imported_cases",0);
 
@@ -127,24 +150,59 @@ shared_ptr<Sim> SimBuilder::Build(shared_ptr<Sim> sim, shared_ptr<Population> po
         // --------------------------------------------------------------
         NonComplianceSeeder(m_config, sim->m_rn_man).Seed(sim->m_population);
 
+        // --------------------------------------------------------------
+        // Partition the contact pool members w.r.t. health status.
+        // --------------------------------------------------------------
+        sim->m_population->SortContactPools();
+
         // --------------------------------------------------------------
         // Done.
         // --------------------------------------------------------------
         return sim;
 }
 
+shared_ptr<Calendar> SimBuilder::MakeCalendar()
+{
+        const auto numDays = m_config.get<unsigned short>("run.num_days");
+        if (!m_input_cache) {
+                return make_shared<Calendar>(m_config, numDays);
+        }
+        // the parameters that the calendar reads
+        const auto key = m_config.get<string>("run.holidays_file", "") + "|" + m_config.get<string>("run.start_date", "") +
+                         "|" + to_string(numDays) + "|" + m_config.get<string>("run.num_daily_imported_cases", "0");
+        lock_guard<mutex> lock(m_input_cache->mutex);
+        auto&             calendars = m_input_cache->calendars;
+        auto              it        = calendars.find(key);
+        if (it == calendars.end()) {
+                it = calendars.emplace(key, make_shared<const Calendar>(m_config, numDays)).first;
+        }
+        return make_shared<Calendar>(*it->second);
+}
+
 ptree SimBuilder::ReadAgeContactPtree()
 {
-        const auto fn = m_config.get<string>("run.age_contact_matrix_file", "contact_matrix.xml");
-        const auto fp = m_config.get<bool>("run.use_install_dirs") ? FileSys::GetDataDir() /= fn : filesys::path(fn);
-        return FileSys::ReadPtreeFile(fp);
+        return ReadDataPtree(m_config.get<string>("run.age_contact_matrix_file", "contact_matrix.xml"));
 }
 
 ptree SimBuilder::ReadDiseasePtree()
 {
-        const auto fn = m_config.get<string>("run.disease_config_file");
-        const auto fp = m_config.get<bool>("run.use_install_dirs") ? FileSys::GetDataDir() /= fn : filesys::path(fn);
-        return FileSys::ReadPtreeFile(fp);
+        return ReadDataPtree(m_config.get<string>("run.disease_config_file"));
+}
+
+ptree SimBuilder::ReadDataPtree(const string& fileName)
+{
+        const auto fp = m_config.get<bool>("run.use_install_dirs") ? FileSys::GetDataDir() /= fileName
+                                                                   : filesys::path(fileName);
+        if (!m_input_cache) {
+                return FileSys::ReadPtreeFile(fp);
+        }
+        lock_guard<mutex> lock(m_input_cache->mutex);
+        auto&             ptrees = m_input_cache->ptrees;
+        auto              it     = ptrees.find(fp.string());
+        if (it == ptrees.end()) {
+                it = ptrees.emplace(fp.string(), FileSys::ReadPtreeFile(fp)).first;
+        }
+        return it->second;
 }
 
 } // namespace stride
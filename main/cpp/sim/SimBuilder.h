@@ -23,13 +23,31 @@
 #include "util/RnMan.h"
 
 #include <boost/property_tree/ptree.hpp>
+#include <map>
 #include <memory>
+#include <mutex>
+#include <string>
 
 namespace stride {
 
+class Calendar;
 class Sim;
 class Population;
 
+/**
+ * Inputs that are read from file once for the simulators that are built one after the
+ * other or concurrently (see SimController): the contact and disease configuration files
+ * and the calendars.
+ */
+struct SimInputCache
+{
+        SimInputCache() : ptrees(), calendars(), mutex() {}
+
+        std::map<std::string, boost::property_tree::ptree>     ptrees;    ///< Configuration files, by path.
+        std::map<std::string, std::shared_ptr<const Calendar>> calendars; ///< Calendars at the start, by parameters.
+        std::mutex                                             mutex;     ///< Guards the maps.
+};
+
 /**
  * Builds a simulator based a configuration property tree.
  * It
@@ -41,21 +59,34 @@ class Population;
 class SimBuilder
 {
 public:
-        /// Initializing SimBuilder.
-        explicit SimBuilder(const boost::property_tree::ptree& config);
+        /// Initializing SimBuilder, reading the inputs through the cache (if any).
+        explicit SimBuilder(const boost::property_tree::ptree& config, SimInputCache* inputCache = nullptr);
+
+        /// No copying.
+        SimBuilder(const SimBuilder&) = delete;
+
+        /// No copy assignment.
+        SimBuilder& operator=(const SimBuilder&) = delete;
 
         /// Build the simulator and return it afterwards.
         std::shared_ptr<Sim> Build(std::shared_ptr<Sim> sim, std::shared_ptr<Population> pop, util::RnMan rnMan);
 
 private:
+        /// Get the calendar at the start of the simulation.
+        std::shared_ptr<Calendar> MakeCalendar();
+
         /// Get the contact configuration data.
         boost::property_tree::ptree ReadAgeContactPtree();
 
         /// Get the disease configuration data.
         boost::property_tree::ptree ReadDiseasePtree();
 
+        /// Get the configuration file (in the data dir if use_install_dirs), from the cache if any.
+        boost::property_tree::ptree ReadDataPtree(const std::string& fileName);
+
 private:
-        boost::property_tree::ptree m_config; ///< Run config in ptree.
+        boost::property_tree::ptree m_config;      ///< Run config in ptree.
+        SimInputCache*              m_input_cache; ///< Inputs read earlier (may be null).
 };
 
 } // namespace stride
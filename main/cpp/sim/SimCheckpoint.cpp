@@ -0,0 +1,450 @@
+/*
+ *  This is free software: you can redistribute it and/or modify it
+ *  under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  any later version.
+ *  The software is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *  You should have received a copy of the GNU General Public License
+ *  along with the software. If not, see <http://www.gnu.org/licenses/>.
+ *
+ *  Copyright 2020, Willem L, Kuylen E, Broeckhove J
+ */
+
+/**
+ * @file
+ * Implementation of the SimCheckpoint class.
+ */
+
+#include "SimCheckpoint.h"
+
+#include "calendar/Calendar.h"
+#include "contact/ContactType.h"
+#include "pop/Population.h"
+#include "sim/Sim.h"
+
+#include <boost/date_time/gregorian/gregorian.hpp>
+#include <array>
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+namespace stride {
+
+using namespace std;
+using namespace stride::ContactType;
+using namespace stride::util;
+
+namespace {
+
+/// Magic and format version of the checkpoint.
+constexpr array<char, 8> MAGIC{{'S', 'T', 'R', 'I', 'D', 'E', 'C', 'P'}};
+constexpr uint32_t       VERSION = 2U;
+
+/// Header of the checkpoint, followed by the random number state, the persons (raw), the
+/// pools of each type, the population's disease queues and contact registers, the scheduled
+/// person events, the queued index cases and the position in the universal testing sweep.
+struct Header
+{
+        array<char, 8> magic;
+        uint32_t       version;
+        uint32_t       person_size;
+        uint32_t       num_types;
+        uint32_t       sim_day;
+        uint32_t       start_date; ///< Day number of the start date.
+        uint32_t       reserved;
+        uint64_t       num_persons;
+};
+
+/// Scheduled person event (see TimingWheel).
+struct StoredEvent
+{
+        uint32_t id;
+        uint32_t day;
+        uint32_t type;
+};
+
+static_assert(is_trivially_copyable<Person>::value, "SimCheckpoint> Person is stored in raw form");
+static_assert(is_trivially_copyable<RnHandler>::value, "SimCheckpoint> RnHandler is stored in raw form");
+
+/// Writes values and vectors (size, then the elements) in raw form.
+class Writer
+{
+public:
+        explicit Writer(FILE* file) : m_file(file), m_ok(true) {}
+
+        template <typename T>
+        void Write(const T& value)
+        {
+                static_assert(is_trivially_copyable<T>::value, "SimCheckpoint> Values are stored in raw form");
+                m_ok = m_ok && fwrite(&value, sizeof(T), 1U, m_file) == 1U;
+        }
+
+        template <typename T>
+        void Write(const vector<T>& values)
+        {
+                static_assert(is_trivially_copyable<T>::value, "SimCheckpoint> Values are stored in raw form");
+                Write<uint64_t>(values.size());
+                m_ok = m_ok && fwrite(values.data(), sizeof(T), values.size(), m_file) == values.size();
+        }
+
+        void Write(const string& s) { Write(vector<char>(s.begin(), s.end())); }
+
+        /// Write the ids of the persons.
+        void WritePersons(const vector<Person*>& persons)
+        {
+                vector<uint32_t> ids(persons.size());
+                for (size_t i = 0U; i < persons.size(); i++) {
+                        ids[i] = persons[i]->GetId();
+                }
+                Write(ids);
+        }
+
+        /// Have all values been written?
+        bool IsOk() const { return m_ok; }
+
+private:
+        FILE* m_file;
+        bool  m_ok;
+};
+
+/// Reads what the Writer wrote; throws if the checkpoint is truncated.
+class Reader
+{
+public:
+        explicit Reader(istream& is) : m_is(is) {}
+
+        template <typename T>
+        void Read(T& value)
+        {
+                if (!m_is.read(reinterpret_cast<char*>(&value), sizeof(T))) {
+                        throw runtime_error("SimCheckpoint::Restore> Truncated checkpoint.");
+                }
+        }
+
+        template <typename T>
+        T Read()
+        {
+                T value{};
+                Read(value);
+                return value;
+        }
+
+        template <typename T>
+        vector<T> ReadVector()
+        {
+                vector<T> values(Read<uint64_t>());
+                if (!m_is.read(reinterpret_cast<char*>(values.data()), static_cast<streamsize>(values.size() * sizeof(T)))) {
+                        throw runtime_error("SimCheckpoint::Restore> Truncated checkpoint.");
+                }
+                return values;
+        }
+
+        string ReadString()
+        {
+                const auto chars = ReadVector<char>();
+                return string(chars.begin(), chars.end());
+        }
+
+        /// Read the ids of persons in the population.
+        vector<Person*> ReadPersons(Population& pop)
+        {
+                const auto      ids = ReadVector<uint32_t>();
+                vector<Person*> persons(ids.size());
+                for (size_t i = 0U; i < ids.size(); i++) {
+                        if (ids[i] >= pop.size()) {
+                                throw runtime_error("SimCheckpoint::Restore> Person id out of range.");
+                        }
+                        persons[i] = &pop[ids[i]];
+                }
+                return persons;
+        }
+
+private:
+        istream& m_is;
+};
+
+} // namespace
+
+void SimCheckpoint::Save(const filesys::path& path, const Sim& sim)
+{
+        if (path.has_parent_path()) {
+                filesys::create_directories(path.parent_path());
+        }
+        const auto tmpPath = path.parent_path() / filesys::unique_path("%%%%-%%%%-%%%%.tmp");
+        unique_ptr<FILE, int (*)(FILE*)> file(fopen(tmpPath.string().c_str(), "wb"), &fclose);
+        if (!file) {
+                throw runtime_error("SimCheckpoint::Save> Cannot open file: " + tmpPath.string());
+        }
+        Writer writer(file.get());
+
+        const auto& pop      = *sim.m_population;
+        const auto& calendar = *sim.m_calendar;
+        const auto  simDay   = calendar.GetSimulationDay();
+        const auto  today    = boost::gregorian::date(static_cast<unsigned short>(calendar.GetYear()),
+                                                  static_cast<unsigned short>(calendar.GetMonth()),
+                                                  static_cast<unsigned short>(calendar.GetDay()));
+        const auto  start    = today - boost::gregorian::days(simDay);
+        writer.Write(Header{MAGIC, VERSION, sizeof(Person), NumOfTypes(), simDay,
+                            static_cast<uint32_t>(start.day_number()), 0U, pop.size()});
+
+        // random numbers
+        const auto info = sim.m_rn_man.GetInfo();
+        writer.Write(info.m_seed_seq_init);
+        writer.Write(info.m_state);
+        writer.Write<uint32_t>(info.m_stream_count);
+        writer.Write<uint8_t>(info.m_counter_based);
+        writer.Write<uint64_t>(sim.m_rn_handlers.size());
+        for (const auto& handler : sim.m_rn_handlers) {
+                writer.Write(handler);
+        }
+
+        // persons
+        for (const auto& p : pop) {
+                writer.Write(p);
+        }
+
+        // pools: members in order, partitions and worklists
+        for (Id typ : IdList) {
+                const auto&      pools = pop.CRefPoolSys().CRefPools(typ);
+                vector<uint32_t> partitions;
+                vector<uint8_t>  active;
+                vector<uint32_t> ids;
+                for (const auto& pool : pools) {
+                        partitions.insert(partitions.end(), {static_cast<uint32_t>(pool.size()), pool.m_num_infectious,
+                                                             pool.m_index_susceptible, pool.m_index_immune});
+                        active.emplace_back(pool.m_is_active);
+                        for (const auto p : pool.GetPool()) {
+                                ids.emplace_back(p->GetId());
+                        }
+                }
+                writer.Write(partitions);
+                writer.Write(active);
+                writer.Write(ids);
+                writer.Write(pop.CRefPoolSys().m_active[typ]);
+        }
+
+        // disease queues, health status counts and contact registers
+        writer.Write<uint64_t>(pop.m_progression.size());
+        for (size_t i = 0U; i < pop.m_progression.size(); i++) {
+                writer.WritePersons(pop.m_progression[i]);
+                writer.WritePersons(pop.m_onsets[i]);
+        }
+        writer.WritePersons(pop.m_symptomatic);
+        array<long long, 7> counts{};
+        for (const auto& c : pop.m_status_counts) {
+                for (size_t i = 0U; i < counts.size(); i++) {
+                        counts[i] += c.counts[i];
+                }
+        }
+        writer.Write(counts);
+        const auto& registers = pop.m_contact_registers;
+        writer.Write<uint64_t>(registers.m_tables.size());
+        for (const auto& table : registers.m_tables) {
+                writer.Write<uint32_t>(table.size);
+                writer.Write(table.slots);
+        }
+        writer.Write(registers.m_free_handles);
+
+        // scheduled person events
+        const auto& wheel = sim.m_person_events;
+        writer.Write<uint32_t>(wheel.m_next_day);
+        writer.Write<uint64_t>(wheel.m_buckets.size());
+        for (const auto& bucket : wheel.m_buckets) {
+                vector<StoredEvent> events;
+                for (const auto& e : bucket) {
+                        events.push_back({e.person->GetId(), e.day, static_cast<uint32_t>(e.type)});
+                }
+                writer.Write(events);
+        }
+
+        // queued index cases, with the day on which they are due
+        const auto& queues = sim.m_public_health_agency.m_index_cases;
+        writer.Write<uint64_t>(queues.size());
+        for (size_t i = 0U; i < queues.size(); i++) {
+                writer.Write<uint32_t>(simDay + static_cast<uint32_t>((i + queues.size() - simDay % queues.size()) %
+                                                                      queues.size()));
+                writer.WritePersons(queues[i]);
+        }
+
+        // universal testing
+        writer.Write<uint32_t>(sim.m_universal_testing.m_unitest_day_in_sweep);
+
+        const bool ok = (fclose(file.release()) == 0) && writer.IsOk();
+        if (!ok) {
+                filesys::remove(tmpPath);
+                throw runtime_error("SimCheckpoint::Save> Cannot write file: " + tmpPath.string());
+        }
+        filesys::rename(tmpPath, path);
+}
+
+void SimCheckpoint::Restore(const filesys::path& path, Sim& sim)
+{
+        ifstream is(path.string(), ios::binary);
+        if (!is) {
+                throw runtime_error("SimCheckpoint::Restore> Cannot open file: " + path.string());
+        }
+        Reader reader(is);
+
+        auto&      pop      = *sim.m_population;
+        auto&      calendar = *sim.m_calendar;
+        const auto header   = reader.Read<Header>();
+        if (header.magic != MAGIC || header.version != VERSION || header.person_size != sizeof(Person) ||
+            header.num_types != NumOfTypes()) {
+                throw runtime_error("SimCheckpoint::Restore> Not a checkpoint of this version: " + path.string());
+        }
+        if (header.num_persons != pop.size()) {
+                throw runtime_error("SimCheckpoint::Restore> Population size differs from the checkpoint.");
+        }
+        if (calendar.GetSimulationDay() != 0U) {
+                throw runtime_error("SimCheckpoint::Restore> The simulator has already run.");
+        }
+        const auto start = boost::gregorian::date(static_cast<unsigned short>(calendar.GetYear()),
+                                                  static_cast<unsigned short>(calendar.GetMonth()),
+                                                  static_cast<unsigned short>(calendar.GetDay()));
+        if (start.day_number() != header.start_date) {
+                throw runtime_error("SimCheckpoint::Restore> Start date differs from the checkpoint.");
+        }
+        const auto simDay = header.sim_day;
+
+        // random numbers: the handlers of counter-based draws are positioned anew for each unit of work
+        const auto seed         = reader.ReadString();
+        const auto state        = reader.ReadString();
+        const auto streamCount  = reader.Read<uint32_t>();
+        const bool counterBased = reader.Read<uint8_t>() != 0U;
+        if (counterBased != sim.m_rn_man.IsCounterBased()) {
+                throw runtime_error("SimCheckpoint::Restore> The rng_type differs from the checkpoint.");
+        }
+        const auto numHandlers = reader.Read<uint64_t>();
+        if (!counterBased && numHandlers != sim.m_rn_handlers.size()) {
+                throw runtime_error("SimCheckpoint::Restore> The number of threads differs from the checkpoint.");
+        }
+        for (size_t i = 0U; i < numHandlers; i++) {
+                auto handler = sim.m_rn_handlers.front();
+                reader.Read(handler);
+                if (!counterBased) {
+                        sim.m_rn_handlers[i] = handler;
+                }
+        }
+        sim.m_rn_man.Initialize(RnInfo(seed, state, streamCount, counterBased));
+        if (counterBased) {
+                // keyed by the restored seed rather than by the seed of the restoring simulator
+                for (unsigned int i = 0U; i < sim.m_rn_handlers.size(); i++) {
+                        sim.m_rn_handlers[i] = RnHandler(sim.m_rn_man.GetCounterKey(), i, true);
+                }
+        }
+
+        // persons
+        for (size_t i = 0U; i < pop.size(); i++) {
+                // the state of the person, over the topology of this population
+                const auto topology = pop[i].m_topology;
+                reader.Read(pop[i]);
+                pop[i].m_topology = topology;
+                if (pop[i].GetId() != i) {
+                        throw runtime_error("SimCheckpoint::Restore> Person ids differ from the checkpoint.");
+                }
+        }
+
+        // pools
+        auto& poolSys = pop.RefPoolSys();
+        for (Id typ : IdList) {
+                auto&      pools      = poolSys.RefPools(typ);
+                const auto partitions = reader.ReadVector<uint32_t>();
+                const auto active     = reader.ReadVector<uint8_t>();
+                const auto ids        = reader.ReadVector<uint32_t>();
+                if (partitions.size() != 4U * pools.size() || active.size() != pools.size()) {
+                        throw runtime_error("SimCheckpoint::Restore> Pools differ from the checkpoint.");
+                }
+                size_t m = 0U;
+                for (size_t i = 0U; i < pools.size(); i++) {
+                        auto& pool = pools[i];
+                        if (partitions[4U * i] != pool.size() || m + pool.size() > ids.size()) {
+                                throw runtime_error("SimCheckpoint::Restore> Pools differ from the checkpoint.");
+                        }
+                        for (auto& member : pool.m_members) {
+                                if (ids[m] >= pop.size()) {
+                                        throw runtime_error("SimCheckpoint::Restore> Person id out of range.");
+                                }
+                                member = &pop[ids[m++]];
+                        }
+                        pool.m_num_infectious    = partitions[4U * i + 1U];
+                        pool.m_index_susceptible = partitions[4U * i + 2U];
+                        pool.m_index_immune      = partitions[4U * i + 3U];
+                        pool.m_is_active         = active[i] != 0U;
+                }
+                poolSys.m_active[typ] = reader.ReadVector<uint32_t>();
+        }
+
+        // disease queues, health status counts and contact registers
+        if (reader.Read<uint64_t>() != pop.m_progression.size()) {
+                throw runtime_error("SimCheckpoint::Restore> Not a checkpoint of this version: " + path.string());
+        }
+        for (size_t i = 0U; i < pop.m_progression.size(); i++) {
+                pop.m_progression[i] = reader.ReadPersons(pop);
+                pop.m_onsets[i]      = reader.ReadPersons(pop);
+        }
+        pop.m_symptomatic = reader.ReadPersons(pop);
+        for (auto& c : pop.m_status_counts) {
+                c.counts.fill(0);
+        }
+        reader.Read(pop.m_status_counts[0].counts);
+        for (auto& log : pop.m_health_transitions) {
+                log.clear();
+        }
+        auto& registers = pop.m_contact_registers;
+        registers.m_tables.resize(reader.Read<uint64_t>());
+        for (auto& table : registers.m_tables) {
+                table.size  = reader.Read<uint32_t>();
+                table.slots = reader.ReadVector<ContactRegisters::Entry>();
+        }
+        registers.m_free_handles = reader.ReadVector<unsigned int>();
+        registers.m_pool.clear();
+
+        // scheduled person events
+        auto& wheel         = sim.m_person_events;
+        wheel.m_next_day    = reader.Read<uint32_t>();
+        wheel.m_num_pending = 0U;
+        wheel.m_buckets.resize(reader.Read<uint64_t>());
+        for (auto& bucket : wheel.m_buckets) {
+                bucket.clear();
+                for (const auto& e : reader.ReadVector<StoredEvent>()) {
+                        if (e.id >= pop.size()) {
+                                throw runtime_error("SimCheckpoint::Restore> Person id out of range.");
+                        }
+                        bucket.push_back({&pop[e.id], e.day, static_cast<TimingWheel::EventType>(e.type)});
+                }
+                wheel.m_num_pending += bucket.size();
+        }
+
+        // queued index cases, in the queues of the (possibly other) delay of this simulator
+        auto& queues = sim.m_public_health_agency.m_index_cases;
+        for (auto& queue : queues) {
+                queue.clear();
+        }
+        const auto numQueues = reader.Read<uint64_t>();
+        for (size_t i = 0U; i < numQueues; i++) {
+                const auto day     = reader.Read<uint32_t>();
+                const auto persons = reader.ReadPersons(pop);
+                if (!persons.empty() && day >= simDay + queues.size()) {
+                        throw runtime_error("SimCheckpoint::Restore> Index cases queued beyond the delay_isolation_index.");
+                }
+                auto& queue = queues[day % queues.size()];
+                queue.insert(queue.end(), persons.begin(), persons.end());
+        }
+
+        // universal testing
+        sim.m_universal_testing.m_unitest_day_in_sweep = reader.Read<uint32_t>();
+
+        while (calendar.GetSimulationDay() < simDay) {
+                calendar.AdvanceDay();
+        }
+}
+
+} // namespace stride
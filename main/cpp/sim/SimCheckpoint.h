@@ -0,0 +1,52 @@
+/*
+ *  This is free software: you can redistribute it and/or modify it
+ *  under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  any later version.
+ *  The software is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *  You should have received a copy of the GNU General Public License
+ *  along with the software. If not, see <http://www.gnu.org/licenses/>.
+ *
+ *  Copyright 2020, Willem L, Kuylen E, Broeckhove J
+ */
+
+/**
+ * @file
+ * Header for the SimCheckpoint class.
+ */
+
+#pragma once
+
+#include "util/FileSys.h"
+
+namespace stride {
+
+class Sim;
+
+/**
+ * Binary checkpoint of a simulator at the start of a day: the persons (health, absences,
+ * isolation and tracing state), the member order and partitions of the contact pools, the
+ * disease progression and onset queues, the contact registers, the scheduled isolations, the
+ * queued index cases of contact tracing, the position in the universal testing sweep, the
+ * calendar day and the state of the random number generators.
+ *
+ * A simulator that is built from the same population file and start date and then restored
+ * continues exactly as the one that was saved. Its configuration is its own, however: the
+ * calendar file, tracing and testing parameters of the restored simulator apply from the day
+ * of the checkpoint on, so that scenarios can branch off a shared first part of a simulation
+ * (see SimController). Random numbers in Stream mode require the same number of threads.
+ */
+class SimCheckpoint
+{
+public:
+        /// Write the checkpoint of the simulator (at the start of its current day).
+        static void Save(const filesys::path& path, const Sim& sim);
+
+        /// Restore the checkpoint into the simulator, which has been built but not run.
+        static void Restore(const filesys::path& path, Sim& sim);
+};
+
+} // namespace stride
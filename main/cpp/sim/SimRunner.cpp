@@ -31,7 +31,7 @@ using namespace std;
 namespace stride {
 
 SimRunner::SimRunner(const ptree& configPt, shared_ptr<Sim> sim)
-    : m_clock("total_clock"), m_config(configPt), m_sim(std::move(sim))
+    : m_clock("total_clock"), m_config(configPt), m_sim(std::move(sim)), m_at_start(true)
 {
         Notify(Id::SetupBegin);
         m_clock.Start();
@@ -46,9 +46,11 @@ void SimRunner::Run(unsigned int numSteps)
                 m_clock.Start();
                 const auto numDays = m_config.get<unsigned int>("run.num_days");
 
-                // We are AtStart: no steps have taken yet, so signal AtStart.
-                if (m_sim->GetCalendar()->GetSimulationDay() == 0) {
+                // We are AtStart: no steps have been taken yet (the simulator may have been
+                // restored from a checkpoint on a later day), so signal AtStart.
+                if (m_at_start) {
                         Notify(Id::AtStart);
+                        m_at_start = false;
                 }
 
                 // Take numSteps but do not go beyond numDays.
@@ -0,0 +1,122 @@
+/*
+ *  This is free software: you can redistribute it and/or modify it
+ *  under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  any later version.
+ *  The software is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *  You should have received a copy of the GNU General Public License
+ *  along with the software. If not, see <http://www.gnu.org/licenses/>.
+ *
+ *  Copyright 2020, Willem L, Kuylen E, Broeckhove J
+ */
+
+/**
+ * @file
+ * Implementation of the TimingWheel class.
+ */
+
+#include "TimingWheel.h"
+
+#include "pop/Person.h"
+
+#include <algorithm>
+#include <stdexcept>
+
+namespace stride {
+
+using namespace std;
+
+namespace {
+
+/// Initial number of days in the wheel (a power of two).
+constexpr size_t INITIAL_SIZE = 16U;
+
+} // namespace
+
+TimingWheel::TimingWheel(unsigned int numThreads)
+    : m_buckets(INITIAL_SIZE), m_same_day(), m_next_day(0U), m_num_pending(0U), m_num_threads(numThreads)
+{
+}
+
+void TimingWheel::Isolate(unsigned int simDay, Person* person, unsigned int from, unsigned int to)
+{
+        Schedule(simDay, person, EventType::StartIsolation, from);
+        Schedule(simDay, person, EventType::EndIsolation, to);
+}
+
+void TimingWheel::Schedule(unsigned int simDay, Person* person, EventType type, unsigned int day)
+{
+        const Event event{person, day, type};
+        if (day < m_next_day) {
+                if (day != simDay) {
+                        throw runtime_error("TimingWheel::Schedule> Person event scheduled in the past.");
+                }
+                m_same_day.emplace_back(event);
+                return;
+        }
+        if (day - m_next_day >= m_buckets.size()) {
+                Grow(day);
+        }
+        m_buckets[day & (m_buckets.size() - 1U)].emplace_back(event);
+        m_num_pending++;
+}
+
+void TimingWheel::Execute(unsigned int simDay)
+{
+        for (; m_next_day <= simDay; m_next_day++) {
+                auto& bucket = m_buckets[m_next_day & (m_buckets.size() - 1U)];
+                if (bucket.empty()) {
+                        continue;
+                }
+
+                // Group the events by person (keeping their order), only the last one of a person counts.
+                stable_sort(bucket.begin(), bucket.end(),
+                            [](const Event& lhs, const Event& rhs) { return less<Person*>()(lhs.person, rhs.person); });
+                const auto num_events = static_cast<long>(bucket.size());
+#pragma omp parallel for num_threads(m_num_threads) schedule(static)
+                for (long i = 0; i < num_events; i++) {
+                        const auto& event = bucket[static_cast<size_t>(i)];
+                        if (i + 1 == num_events || bucket[static_cast<size_t>(i + 1)].person != event.person) {
+                                Apply(event);
+                        }
+                }
+                m_num_pending -= bucket.size();
+                bucket.clear();
+        }
+}
+
+void TimingWheel::ExecuteSameDay()
+{
+        for (const auto& event : m_same_day) {
+                Apply(event);
+        }
+        m_same_day.clear();
+}
+
+void TimingWheel::Apply(const Event& event)
+{
+        switch (event.type) {
+        case EventType::StartIsolation: event.person->SetIsolated(true); break;
+        case EventType::EndIsolation: event.person->SetIsolated(false); break;
+        }
+}
+
+void TimingWheel::Grow(unsigned int day)
+{
+        size_t size = m_buckets.size();
+        while (day - m_next_day >= size) {
+                size *= 2U;
+        }
+        vector<vector<Event>> buckets(size);
+        for (auto& bucket : m_buckets) {
+                for (const auto& event : bucket) {
+                        buckets[event.day & (size - 1U)].emplace_back(event);
+                }
+        }
+        m_buckets = std::move(buckets);
+}
+
+} // namespace stride
@@ -0,0 +1,100 @@
+/*
+ *  This is free software: you can redistribute it and/or modify it
+ *  under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  any later version.
+ *  The software is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *  You should have received a copy of the GNU General Public License
+ *  along with the software. If not, see <http://www.gnu.org/licenses/>.
+ *
+ *  Copyright 2020, Willem L, Kuylen E, Broeckhove J
+ */
+
+/**
+ * @file
+ * Header for the TimingWheel class.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace stride {
+
+class Person;
+
+/**
+ * Calendar queue for the scheduled events of persons (start and end of isolation).
+ * The events are kept in one bucket per simulation day; the buckets form a wheel
+ * that is indexed by the day modulo its size and grows when an event lies beyond it.
+ * The events of a day are executed once, at the start of the day, before the persons
+ * are updated. Events of one person on the same day are executed in the order in
+ * which they were scheduled; the events of different persons are executed in parallel.
+ * Events that are scheduled for the current day after its start (e.g. by contact tracing
+ * with delay_contact_tracing 0) are executed after the contact phase of the day: the
+ * persons take part in the contacts of the day as they were at its start.
+ */
+class TimingWheel
+{
+public:
+        /// Types of person events.
+        enum class EventType : std::uint8_t
+        {
+                StartIsolation,
+                EndIsolation
+        };
+
+public:
+        /// Wheel for the given number of (OpenMP) threads.
+        explicit TimingWheel(unsigned int numThreads = 1U);
+
+        /// Isolate the person from day 'from' up to day 'to', scheduled on the given day.
+        void Isolate(unsigned int simDay, Person* person, unsigned int from, unsigned int to);
+
+        /// Schedule an event on the given day. An event for simDay, whose events have been
+        /// executed at its start, is executed with ExecuteSameDay.
+        void Schedule(unsigned int simDay, Person* person, EventType type, unsigned int day);
+
+        /// Execute the events up to and including the given day.
+        void Execute(unsigned int simDay);
+
+        /// Execute the events that were scheduled for the current day after its start, in the
+        /// order in which they were scheduled. Called after the contact phase of the day.
+        void ExecuteSameDay();
+
+        /// Number of events that have not been executed yet.
+        std::size_t GetNumPending() const { return m_num_pending + m_same_day.size(); }
+
+private:
+        /// Person event.
+        struct Event
+        {
+                Person*      person; ///< Person involved.
+                unsigned int day;    ///< Day of execution.
+                EventType    type;   ///< Type of event.
+        };
+
+private:
+        /// Execute the event for its person.
+        static void Apply(const Event& event);
+
+        /// Grow the wheel (to a power of two) so that it covers the given day.
+        void Grow(unsigned int day);
+
+        /// Saves and restores the scheduled events.
+        friend class SimCheckpoint;
+
+private:
+        std::vector<std::vector<Event>> m_buckets;     ///< Events per day, indexed by day modulo size.
+        std::vector<Event>              m_same_day;    ///< Events for the current day, scheduled after its start.
+        unsigned int                    m_next_day;    ///< First day whose events have not been executed.
+        std::size_t                     m_num_pending; ///< Number of events in the buckets.
+        unsigned int                    m_num_threads; ///< Number of (OpenMP) threads.
+};
+
+} // namespace stride
@@ -37,10 +37,11 @@ std::shared_ptr<spdlog::logger> LogUtils::CreateCliLogger(const string& logger_n
                 throw runtime_error("LogUtils::CreateCliLogger> Creating already registered logger" + logger_name);
         }
         try {
+                // thread-safe sinks: concurrent runs share the logger (see SimController)
                 vector<sink_ptr> sinks;
-                const auto       color_sink = make_shared<ansicolor_stdout_sink_st>();
+                const auto       color_sink = make_shared<ansicolor_stdout_sink_mt>();
                 sinks.push_back(color_sink);
-                sinks.push_back(make_shared<simple_file_sink_st>(file_name));
+                sinks.push_back(make_shared<simple_file_sink_mt>(file_name));
                 lggr = make_shared<logger>(logger_name, begin(sinks), end(sinks));
         } catch (const spdlog_ex& e) {
                 cerr << "LogUtils::CreateCliLogger> Logger initialization failed for " << logger_name
@@ -58,7 +59,7 @@ std::shared_ptr<spdlog::logger> LogUtils::CreateFileLogger(const string& logger_
                 throw runtime_error("LogUtils::CreateFileLogger> Creating already registered logger" + logger_name);
         }
         try {
-                const auto sink = make_shared<simple_file_sink_st>(file_name, true);
+                const auto sink = make_shared<simple_file_sink_mt>(file_name, true);
                 lggr            = make_shared<logger>(logger_name, sink);
         } catch (const spdlog_ex& e) {
                 cerr << "LogUtils::CreateFileLogger> Logger initialization failed for " << logger_name
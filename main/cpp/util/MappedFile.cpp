@@ -0,0 +1,86 @@
+/*
+ *  This is free software: you can redistribute it and/or modify it
+ *  under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  any later version.
+ *  The software is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *  You should have received a copy of the GNU General Public License
+ *  along with the software. If not, see <http://www.gnu.org/licenses/>.
+ *
+ *  Copyright 2020, Willem L, Kuylen E, Broeckhove J
+ */
+
+/**
+ * @file
+ * Implementation of the MappedFile class.
+ */
+
+#include "MappedFile.h"
+
+#include <fstream>
+#include <iterator>
+#include <stdexcept>
+
+#if !defined(WIN32)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace stride {
+namespace util {
+
+using namespace std;
+
+MappedFile::MappedFile(const string& fileName) : m_data(nullptr), m_size(0U), m_mapped(false), m_buffer()
+{
+#if defined(WIN32)
+        ifstream file(fileName, ios::binary);
+        if (!file.is_open()) {
+                throw runtime_error("MappedFile::MappedFile> Cannot open file: " + fileName);
+        }
+        m_buffer.assign(istreambuf_iterator<char>(file), istreambuf_iterator<char>());
+        m_data = m_buffer.data();
+        m_size = m_buffer.size();
+#else
+        const int fd = open(fileName.c_str(), O_RDONLY);
+        if (fd < 0) {
+                throw runtime_error("MappedFile::MappedFile> Cannot open file: " + fileName);
+        }
+        struct stat info{};
+        if (fstat(fd, &info) != 0) {
+                close(fd);
+                throw runtime_error("MappedFile::MappedFile> Cannot stat file: " + fileName);
+        }
+        m_size = static_cast<size_t>(info.st_size);
+        if (m_size > 0U) {
+                void* data = mmap(nullptr, m_size, PROT_READ, MAP_PRIVATE, fd, 0);
+                if (data == MAP_FAILED) {
+                        close(fd);
+                        throw runtime_error("MappedFile::MappedFile> Cannot map file: " + fileName);
+                }
+                madvise(data, m_size, MADV_SEQUENTIAL);
+                m_data   = static_cast<const char*>(data);
+                m_mapped = true;
+        } else {
+                m_data = m_buffer.data();
+        }
+        close(fd);
+#endif
+}
+
+MappedFile::~MappedFile()
+{
+#if !defined(WIN32)
+        if (m_mapped) {
+                munmap(const_cast<char*>(m_data), m_size);
+        }
+#endif
+}
+
+} // namespace util
+} // namespace stride
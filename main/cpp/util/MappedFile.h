@@ -0,0 +1,65 @@
+/*
+ *  This is free software: you can redistribute it and/or modify it
+ *  under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  any later version.
+ *  The software is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *  You should have received a copy of the GNU General Public License
+ *  along with the software. If not, see <http://www.gnu.org/licenses/>.
+ *
+ *  Copyright 2020, Willem L, Kuylen E, Broeckhove J
+ */
+
+/**
+ * @file
+ * Header for the MappedFile class.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <string>
+
+namespace stride {
+namespace util {
+
+/**
+ * Read-only view of the contents of a file. The file is memory-mapped (on platforms
+ * without mmap, it is read into memory); the view is valid for the lifetime of the object.
+ */
+class MappedFile
+{
+public:
+        /// Map the file, throws a runtime_error if it cannot be opened or mapped.
+        explicit MappedFile(const std::string& fileName);
+
+        /// Unmaps the file.
+        ~MappedFile();
+
+        /// No copying.
+        MappedFile(const MappedFile&) = delete;
+
+        /// No copy assignment.
+        MappedFile& operator=(const MappedFile&) = delete;
+
+        /// First byte of the contents.
+        const char* begin() const { return m_data; }
+
+        /// Past the last byte of the contents.
+        const char* end() const { return m_data + m_size; }
+
+        /// Number of bytes.
+        std::size_t size() const { return m_size; }
+
+private:
+        const char* m_data;   ///< Contents of the file.
+        std::size_t m_size;   ///< Size of the file.
+        bool        m_mapped; ///< Is m_data mapped (rather than m_buffer)?
+        std::string m_buffer; ///< Contents when the file is not mapped.
+};
+
+} // namespace util
+} // namespace stride
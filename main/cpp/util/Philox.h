@@ -0,0 +1,65 @@
+/*
+ *  This is free software: you can redistribute it and/or modify it
+ *  under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  any later version.
+ *  The software is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *  You should have received a copy of the GNU General Public License
+ *  along with the software. If not, see <http://www.gnu.org/licenses/>.
+ *
+ *  Copyright 2020, Willem L, Kuylen E, Broeckhove J
+ */
+
+/**
+ * @file
+ * Definition of Philox.
+ */
+
+#pragma once
+
+#include <array>
+#include <cstdint>
+
+namespace stride {
+namespace util {
+
+/**
+ * Counter-based random number generator Philox4x32-10 (Salmon et al., "Parallel random
+ * numbers: as easy as 1, 2, 3", SC 2011). The output is a pure function of a 128-bit
+ * counter and a 64-bit key: there is no engine state, so any thread can produce the
+ * draws of any counter value.
+ */
+class Philox
+{
+public:
+        using Counter = std::array<std::uint32_t, 4>;
+        using Key     = std::array<std::uint32_t, 2>;
+
+        /// Random 128 bits for the counter under the key.
+        static Counter Generate(Counter ctr, Key key)
+        {
+                for (unsigned int round = 0U; round < 10U; ++round) {
+                        if (round > 0U) {
+                                key[0] += W0;
+                                key[1] += W1;
+                        }
+                        const std::uint64_t p0 = static_cast<std::uint64_t>(M0) * ctr[0];
+                        const std::uint64_t p1 = static_cast<std::uint64_t>(M1) * ctr[2];
+                        ctr = {{static_cast<std::uint32_t>(p1 >> 32U) ^ ctr[1] ^ key[0], static_cast<std::uint32_t>(p1),
+                                static_cast<std::uint32_t>(p0 >> 32U) ^ ctr[3] ^ key[1], static_cast<std::uint32_t>(p0)}};
+                }
+                return ctr;
+        }
+
+private:
+        static constexpr std::uint32_t M0 = 0xD2511F53U; ///< Multiplier of the first pair of words.
+        static constexpr std::uint32_t M1 = 0xCD9E8D57U; ///< Multiplier of the second pair of words.
+        static constexpr std::uint32_t W0 = 0x9E3779B9U; ///< Key schedule (golden ratio).
+        static constexpr std::uint32_t W1 = 0xBB67AE85U; ///< Key schedule (sqrt(3) - 1).
+};
+
+} // namespace util
+} // namespace stride
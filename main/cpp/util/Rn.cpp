@@ -35,7 +35,7 @@ namespace util {
 template <typename E>
 bool Rn<E>::operator==(const Rn& other)
 {
-        bool status = m_stream_count == other.m_stream_count;
+        bool status = m_stream_count == other.m_stream_count && m_counter_based == other.m_counter_based;
         if (status) {
                 for (size_t i = 0; i < size(); ++i) {
                         status = status && ((*this)[i] == other[i]);
@@ -55,28 +55,35 @@ RnInfo Rn<E>::GetInfo() const
         info.m_seed_seq_init = m_seed_seq_init;
         info.m_state         = ss.str();
         info.m_stream_count  = m_stream_count;
+        info.m_counter_based = m_counter_based;
         return info;
 }
 
 template <typename E>
 void Rn<E>::Initialize(const RnInfo& info)
 {
-        if (m_stream_count != info.m_stream_count) {
-                m_stream_count = info.m_stream_count;
+        // a counter-based manager only needs one engine, for the sequential draws
+        const unsigned int stream_count = info.m_counter_based ? 1U : info.m_stream_count;
+        if (m_stream_count != stream_count) {
+                m_stream_count = stream_count;
                 this->resize(m_stream_count);
         }
         m_seed_seq_init = info.m_seed_seq_init;
+        m_counter_based = info.m_counter_based;
+
+        std::vector<unsigned int> seseq_init_vec;
+        for (const auto& e : Split(m_seed_seq_init, ",")) {
+                if (!CheckAllDigits(e)) {
+                        throw std::runtime_error("Rn::Seed> Error in seeding definiton: " + e);
+                }
+                seseq_init_vec.push_back(FromString<unsigned int>(e));
+        }
+        // the key only depends on the seed, not on the state of the engines
+        randutils::seed_seq_fe128 keySeq(seseq_init_vec.begin(), seseq_init_vec.end());
+        m_counter_key = pcg_extras::generate_one<std::uint64_t>(keySeq);
 
         auto state = info.m_state;
         if (state.empty()) {
-                std::vector<unsigned int> seseq_init_vec;
-                const auto string_vec{Split(m_seed_seq_init, ",")};
-                for (const auto& e : Split(m_seed_seq_init, ",")) {
-                        if (!CheckAllDigits(e)) {
-                                throw std::runtime_error("Rn::Seed> Error in seeding definiton: " + e);
-                        }
-                        seseq_init_vec.push_back(FromString<unsigned int>(e));
-                }
                 randutils::seed_seq_fe128 seseq(seseq_init_vec.begin(), seseq_init_vec.end());
 
                 Seed(seseq);
@@ -26,6 +26,7 @@
 #include <trng/lcg64.hpp>
 #include <trng/uniform01_dist.hpp>
 #include <trng/uniform_int_dist.hpp>
+#include <cstdint>
 #include <functional>
 #include <pcg/pcg_random.hpp>
 #include <random>
@@ -53,12 +54,12 @@ public:
 
 public:
         /// Default constructor build empty manager.
-        Rn() : ContainerType(), m_seed_seq_init(""), m_stream_count(0U) {}
+        Rn() : ContainerType(), m_seed_seq_init(""), m_stream_count(0U), m_counter_based(false), m_counter_key(0U) {}
 
         /// Initializes.
         explicit Rn(const RnInfo& info)
-            : ContainerType(info.m_stream_count), m_seed_seq_init(info.m_seed_seq_init),
-              m_stream_count(info.m_stream_count)
+            : ContainerType(), m_seed_seq_init(info.m_seed_seq_init), m_stream_count(0U), m_counter_based(false),
+              m_counter_key(0U)
         {
                 Initialize(info);
         }
@@ -81,6 +82,15 @@ public:
                 return ContainerType::at(i).variate_generator(trng::uniform01_dist<double>());
         }
 
+        /// Are the parallel draws counter-based (see RnHandler) instead of one engine per thread?
+        bool IsCounterBased() const { return m_counter_based; }
+
+        /// Key of the counter-based draws, derived from the seed.
+        std::uint64_t GetCounterKey() const { return m_counter_key; }
+
+        /// Return a raw draw of the i-th random engine, to seed an engine that is derived from it.
+        std::uint64_t GetSeed(unsigned int i = 0U) { return static_cast<std::uint64_t>(ContainerType::at(i).engine()()); }
+
         /// Return a generator for uniform ints in [a, b[ (a < b) using i-th random engine.
         std::function<int()> GetUniformIntGenerator(int a, int b, unsigned int i = 0U)
         {
@@ -117,8 +127,10 @@ private:
         void Seed(randutils::seed_seq_fe128& seseq);
 
 private:
-        std::string  m_seed_seq_init; ///< Seed sequence initializer used with engines.
-        unsigned int m_stream_count;  ///< Number of threads/streams set up with the engine.
+        std::string   m_seed_seq_init; ///< Seed sequence initializer used with engines.
+        unsigned int  m_stream_count;  ///< Number of threads/streams set up with the engine.
+        bool          m_counter_based; ///< Counter-based parallel draws (one stream only).
+        std::uint64_t m_counter_key;   ///< Key of the counter-based draws.
 };
 
 template <>
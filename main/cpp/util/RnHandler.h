@@ -21,42 +21,154 @@
 
 #pragma once
 
+#include <array>
 #include <cmath>
-#include <functional>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <pcg/pcg_random.hpp>
+
+#include "Philox.h"
 
 namespace stride {
 namespace util {
 
 /**
  * Draw random numbers [0,1] and perform binomial trials (or Bernouilli trials).
+ * The handler owns its random engine, so draws are inlined instead of going through
+ * a std::function and a distribution object. Uniforms are produced a block at a time
+ * and handed out from the block. Each (OpenMP) thread has its own handler; handlers
+ * are aligned to cache lines, so that threads do not share lines in a vector of handlers.
+ *
+ * A counter-based handler draws from the Philox generator instead. Before each unit of
+ * work (a contact pool, a person, ...) the handler is positioned with SetKey, so that the
+ * draws are a pure function of the seed, the simulation day, the purpose and the unit.
+ * The results then do not depend on the number of threads or on which thread does the work.
+ * For a sequential handler SetKey does nothing.
  */
-class RnHandler
+class alignas(64) RnHandler
 {
 public:
-        /// Constructor sets the transmission probability and random number generator.
-        explicit RnHandler(std::function<double()> gen) : m_uniform01_generator(std::move(gen)) {}
+        /// Engine type of the handlers, and of the streams of RnMan that seed them.
+        using EngineType = pcg64;
+
+        /// Purpose of the draws, part of the key of a counter-based handler.
+        enum class Purpose : std::uint8_t
+        {
+                HealthSeeding  = 0U,
+                DiseaseSeeding = 1U,
+                Import         = 2U,
+                Update         = 3U,
+                Tracing        = 4U,
+                Testing        = 5U,
+                Contact        = 6U,
+                TraceIndexCase = 7U
+        };
+
+        /// Constructor seeds the engine with the given seed (e.g. a draw from RnMan) and stream.
+        /// With counterBased, the seed is the key of the Philox generator and the stream is not used.
+        RnHandler(std::uint64_t seed, std::uint64_t stream, bool counterBased = false)
+            : m_engine(seed, stream), m_key{{static_cast<std::uint32_t>(seed), static_cast<std::uint32_t>(seed >> 32U)}},
+              m_counter(), m_counter_based(counterBased), m_block(), m_next(0U), m_end(0U)
+        {
+        }
 
         /// Make a draw on the uniform generator.
-        double operator()() { return m_uniform01_generator(); }
+        double operator()()
+        {
+                if (m_next == m_end) {
+                        Refill();
+                }
+                return m_block[m_next++];
+        }
+
+        /// Is the handler counter-based?
+        bool IsCounterBased() const { return m_counter_based; }
+
+        /// Position a counter-based handler at the start of the draws for the given simulation day,
+        /// purpose, and unit of work (e.g. contact type and pool id, or person id).
+        void SetKey(unsigned int simDay, Purpose purpose, unsigned int type, unsigned int id)
+        {
+                if (m_counter_based) {
+                        m_counter = {{(simDay & 0xFFFFU) | (static_cast<std::uint32_t>(purpose) << 16U) |
+                                          ((type & 0xFFU) << 24U),
+                                      id, 0U, 0U}};
+                        m_next = m_end = 0U;
+                }
+        }
 
         /// Perform binomial trial with given probability.
 		bool Binomial(double probability_a)
 		{
-				return m_uniform01_generator() < probability_a;
+				return (*this)() < probability_a;
 		}
 
 		/// Perform binomial trial with given the product of the given probabilities.
         bool Binomial(double probability_a, double probability_b)
         {
-                return m_uniform01_generator() < probability_a * probability_b;
+                return (*this)() < probability_a * probability_b;
+        }
+
+        /// Number of failed binomial trials with given probability before the first success,
+        /// i.e. a geometric draw. Returns the maximum size_t value when success is impossible.
+        std::size_t Geometric(double probability)
+        {
+                if (probability >= 1.0) {
+                        return 0U;
+                }
+                if (probability <= 0.0) {
+                        return std::numeric_limits<std::size_t>::max();
+                }
+                const double failures = std::floor(std::log(1.0 - (*this)()) / std::log1p(-probability));
+                return failures < static_cast<double>(std::numeric_limits<std::size_t>::max())
+                           ? static_cast<std::size_t>(failures)
+                           : std::numeric_limits<std::size_t>::max();
         }
 
 private:
         /// Convert (exponential) rate into probability
         double RateToProbability(double rate) { return 1.0 - std::exp(-rate); }
 
+        /// Uniform double in [0.0, 1.0) from the upper 53 bits.
+        static double ToUniform(std::uint64_t bits) { return static_cast<double>(bits >> 11U) * 0x1.0p-53; }
+
+        /// Fill the block with uniform doubles: the whole block from the engine, or a few
+        /// from the next counter values (units of work mostly need only a few draws).
+        void Refill()
+        {
+                if (m_counter_based) {
+                        for (std::size_t i = 0U; i < COUNTER_BLOCK_SIZE; i += 2U) {
+                                const auto r = Philox::Generate(m_counter, m_key);
+                                m_block[i]     = ToUniform((static_cast<std::uint64_t>(r[0]) << 32U) | r[1]);
+                                m_block[i + 1] = ToUniform((static_cast<std::uint64_t>(r[2]) << 32U) | r[3]);
+                                if (++m_counter[3] == 0U) {
+                                        ++m_counter[2];
+                                }
+                        }
+                        m_end = COUNTER_BLOCK_SIZE;
+                } else {
+                        for (auto& u : m_block) {
+                                u = ToUniform(m_engine());
+                        }
+                        m_end = BLOCK_SIZE;
+                }
+                m_next = 0U;
+        }
+
 private:
-        std::function<double()> m_uniform01_generator; ///< Random number generator: double in [0.0, 1.0)
+        /// Number of uniforms per block.
+        static constexpr std::size_t BLOCK_SIZE = 256U;
+
+        /// Number of uniforms per block of a counter-based handler.
+        static constexpr std::size_t COUNTER_BLOCK_SIZE = 2U;
+
+        EngineType                     m_engine;        ///< Random engine.
+        Philox::Key                    m_key;           ///< Key (seed) of the counter-based generator.
+        Philox::Counter                m_counter;       ///< Day, purpose, type; unit id; draw count.
+        bool                           m_counter_based; ///< Draw from the counter-based generator?
+        std::array<double, BLOCK_SIZE> m_block;         ///< Block of uniform doubles in [0.0, 1.0).
+        std::size_t                    m_next;          ///< Index of the next uniform in the block.
+        std::size_t                    m_end;           ///< Number of uniforms in the block.
 };
 
 } // namespace util
@@ -31,18 +31,22 @@ namespace util {
  */
 struct RnInfo
 {
-        explicit RnInfo(std::string seed_seq_init = "1,2,3,4", std::string state = "", unsigned int stream_count = 1U)
-            : m_seed_seq_init(std::move(seed_seq_init)), m_state(std::move(state)), m_stream_count(stream_count){};
+        explicit RnInfo(std::string seed_seq_init = "1,2,3,4", std::string state = "", unsigned int stream_count = 1U,
+                        bool counter_based = false)
+            : m_seed_seq_init(std::move(seed_seq_init)), m_state(std::move(state)), m_stream_count(stream_count),
+              m_counter_based(counter_based){};
 
         std::string  m_seed_seq_init; ///< Seed for the engine.
         std::string  m_state;         ///< Long string representing current state.
         unsigned int m_stream_count;  ///< Number of streams set up with the engine.
+        bool         m_counter_based; ///< Counter-based parallel draws instead of a stream per thread.
 };
 
 inline std::ostream& operator<<(std::ostream& os, const RnInfo& info)
 {
         os << "Seed sequence: " << info.m_seed_seq_init << "\n"
            << "Number of streams: " << info.m_stream_count << "\n"
+           << "Counter-based: " << std::boolalpha << info.m_counter_based << "\n"
            << "State: " << info.m_state;
         return os;
 }
@@ -20,10 +20,10 @@
 
 #include "RnMan.h"
 #include "Rn.h"
+#include "RnHandler.h"
 #include "StringUtils.h"
 
 #include <trng/discrete_dist.hpp>
-#include <trng/lcg64.hpp>
 #include <trng/uniform01_dist.hpp>
 #include <trng/uniform_int_dist.hpp>
 #include <array>
@@ -38,28 +38,15 @@ using namespace randutils;
 namespace stride {
 namespace util {
 
-// The construction below lets you choose (at compile time)
-// between the pcg64 and trng::lcg64 random engines. It's a hacky
-// construct but required because the forward class definition
-// of RnEgine in RnMan.h cannot be combined with a using
-// statement here. A macro to generate the class definition
-// would make it more scaleable, but since we have only two ...
-
-// If you want to use the pcg64 random engine, uncomment the
-// class definition here and keep the one below commented out.
-class RnEngine : public Rn<pcg64>
-{
-        using Rn<pcg64>::Rn;
-};
-
-// If you want to use the trng::lcg64 random engine, uncomment the
-// class definition here and keep the one above commented out.
-/*
-class RnLcg64 : public Rn<trng::lcg64>
+// The engine type is chosen (at compile time) in one place, RnHandler::EngineType: the
+// streams of the manager and the handlers that are seeded from them (see GetSeed) draw
+// from engines of that type. The handlers construct the engine from a seed and a stream
+// index, as pcg64 does; the trng engines (e.g. trng::lcg64) do not have that constructor.
+// The rng_type of the configuration only selects the parallel draws (Stream or Counter).
+class RnEngine : public Rn<RnHandler::EngineType>
 {
-        using Rn<trng::lcg64>::Rn;
+        using Rn<RnHandler::EngineType>::Rn;
 };
-*/
 
 RnMan::RnMan() : m_rn(make_shared<RnEngine>()) {}
 
@@ -71,6 +58,12 @@ RnInfo RnMan::GetInfo() const { return m_rn->GetInfo(); }
 
 std::function<double()> RnMan::GetUniform01Generator(unsigned int i) { return m_rn->GetUniform01Generator(i); }
 
+bool RnMan::IsCounterBased() const { return m_rn->IsCounterBased(); }
+
+std::uint64_t RnMan::GetCounterKey() const { return m_rn->GetCounterKey(); }
+
+std::uint64_t RnMan::GetSeed(unsigned int i) { return m_rn->GetSeed(i); }
+
 std::function<int()> RnMan::GetUniformIntGenerator(int a, int b, unsigned int i)
 {
         return m_rn->GetUniformIntGenerator(a, b, i);
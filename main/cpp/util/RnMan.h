@@ -22,6 +22,7 @@
 
 #include "RnInfo.h"
 
+#include <cstdint>
 #include <functional>
 #include <memory>
 #include <vector>
@@ -53,6 +54,15 @@ public:
         /// Return a generator for uniform doubles in [0, 1[ using i-th random stream.
         std::function<double()> GetUniform01Generator(unsigned int i = 0U);
 
+        /// Are the parallel draws counter-based (see RnHandler) instead of one stream per thread?
+        bool IsCounterBased() const;
+
+        /// Key of the counter-based draws, derived from the seed.
+        std::uint64_t GetCounterKey() const;
+
+        /// Return a raw draw of the i-th random stream, to seed an engine that is derived from it.
+        std::uint64_t GetSeed(unsigned int i = 0U);
+
         /// Return a generator for uniform ints in [a, b[ (a < b) using i-th random stream.
         std::function<int()> GetUniformIntGenerator(int a, int b, unsigned int i = 0U);
 
@@ -61,6 +61,11 @@ void CliViewer::Update(const sim_event::Id id)
         case Id::Finished: {
                 const auto sim = m_runner->GetSim();
                 m_logger->info("   SimRunner done after: {}", m_runner->GetClock().ToString());
+                const auto& scheduler = sim->CRefContactScheduler();
+                for (unsigned int i = 0; i < scheduler.GetNumThreads(); i++) {
+                        m_logger->info("   Contact phase thread {:2}: busy {}, idle {}", i,
+                                       scheduler.CRefBusyClock(i).ToString(), scheduler.CRefIdleClock(i).ToString());
+                }
                 break;
         }
         default: break;
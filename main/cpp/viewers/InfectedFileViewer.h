@@ -42,7 +42,7 @@ public:
         void Update(sim_event::Id id);
 
 private:
-        const std::string&         m_output_prefix;
+        const std::string          m_output_prefix;
         std::vector<unsigned int>  m_infected;
         std::vector<unsigned int>  m_exposed;
         std::vector<unsigned int>  m_infectious;
@@ -43,7 +43,7 @@ public:
         void Update(sim_event::Id id);
 
 private:
-        const std::string& m_output_prefix;
+        const std::string          m_output_prefix;
         std::shared_ptr<SimRunner> m_runner;
 };
 
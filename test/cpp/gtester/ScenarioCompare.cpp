@@ -0,0 +1,317 @@
+/*
+ *  This is free software: you can redistribute it and/or modify it
+ *  under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  any later version.
+ *  The software is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *  You should have received a copy of the GNU General Public License
+ *  along with the software. If not, see <http://www.gnu.org/licenses/>.
+ *
+ *  Copyright 2020 Willem L, Kuylen E, Stijven S & Broeckhove J
+ */
+
+/**
+ * @file
+ * Implementation of scenario tests that compare the results of runs that should be equal.
+ */
+
+#include "ScenarioData.h"
+#include "execs/SimController.h"
+#include "pop/EventLog.h"
+#include "pop/Population.h"
+#include "sim/Sim.h"
+#include "util/FileSys.h"
+
+#include <algorithm>
+#include <boost/property_tree/ptree.hpp>
+#include <fstream>
+#include <gtest/gtest.h>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <tuple>
+#include <vector>
+
+using namespace std;
+using namespace stride;
+using namespace stride::util;
+using namespace ::testing;
+using boost::property_tree::ptree;
+
+namespace Tests {
+
+namespace {
+
+/// Output prefix for a run of the current test, without the output of earlier test runs
+/// (the event log is appended to).
+string GetOutputPrefix(const string& runTag)
+{
+        const auto prefix =
+            string("tests/gtester_") + UnitTest::GetInstance()->current_test_info()->name() + "_" + runTag;
+        filesys::remove_all(prefix);
+        return prefix;
+}
+
+/// Append the lines of the stream to the lines.
+void ReadLines(istream& is, vector<string>& lines)
+{
+        string line;
+        while (getline(is, line)) {
+                lines.emplace_back(line);
+        }
+}
+
+/// The contents of the file.
+string ReadFile(const filesys::path& path)
+{
+        ifstream      is(path.string());
+        ostringstream ss;
+        ss << is.rdbuf();
+        return ss.str();
+}
+
+/// Run the rows of the experiment design (csv contents) with the output prefix of the run tag,
+/// which is returned.
+string RunDesign(ptree config, const string& design, const string& runTag)
+{
+        const auto prefix     = GetOutputPrefix(runTag);
+        const auto designFile = prefix + "_design.csv";
+        ofstream(designFile) << design;
+        config.put("run.output_prefix", prefix + "/");
+        config.put("run.design_file", designFile);
+        SimController controller(config, "TestController");
+        controller.ControlBatch();
+        return prefix + "/";
+}
+
+/// Run the scenario with the output prefix of the run tag.
+shared_ptr<Sim> RunScenario(ptree config, const string& runTag)
+{
+        config.put("run.output_prefix", GetOutputPrefix(runTag));
+        SimController controller(config, "TestController");
+        controller.Control();
+        return controller.GetSim();
+}
+
+/// The health status of each person, in order of id.
+vector<unsigned int> GetHealthStatus(const Population& pop)
+{
+        vector<unsigned int> status(pop.size());
+        for (const auto& p : pop) {
+                status[p.GetId()] = static_cast<unsigned int>(p.GetHealth().GetStatus());
+        }
+        return status;
+}
+
+} // namespace
+
+TEST(ScenarioCompare, event_log_binary)
+{
+        // -----------------------------------------------------------------------------------------
+        // Scenario with seeding, imports, transmissions, survey contacts and contact tracing.
+        // -----------------------------------------------------------------------------------------
+        auto config = get<0>(ScenarioData::Get("covid19_tracing"));
+        config.put("run.event_log_level", "All");
+        config.put("run.event_output_file", true);
+        config.put("run.num_daily_imported_cases", 10U);
+        config.put("run.start_date", "2020-06-20"); // imported cases as from July
+        config.put("run.num_days", 20U);
+
+        // -----------------------------------------------------------------------------------------
+        // Same run with a text and with a binary event log (decoded after the text lines).
+        // -----------------------------------------------------------------------------------------
+        vector<string> lines[2];
+        vector<string> decoded;
+        for (const auto format : {"Text", "Binary"}) {
+                const auto prefix = GetOutputPrefix(format);
+                const bool binary = string(format) == "Binary";
+                config.put("run.event_log_format", format);
+                config.put("run.output_prefix", prefix);
+                {
+                        SimController controller(config, "TestController");
+                        controller.Control();
+                }
+                ifstream text(FileSys::BuildPath(prefix, "event_log.txt").string());
+                ReadLines(text, lines[binary]);
+                if (binary) {
+                        stringstream ss;
+                        EventLog::Decode(FileSys::BuildPath(prefix, "event_log.bin").string(), ss);
+                        ReadLines(ss, decoded);
+                        lines[1].insert(lines[1].end(), decoded.begin(), decoded.end());
+                }
+        }
+
+        // -----------------------------------------------------------------------------------------
+        // The decoded log has the lines of the text log (as a multiset: threads interleave).
+        // -----------------------------------------------------------------------------------------
+        for (const string tag : {"[PRIM]", "[IMPORT-CASES]", "[TRAN]", "[CONT]"}) {
+                EXPECT_TRUE(any_of(decoded.begin(), decoded.end(),
+                                   [&tag](const string& line) { return line.compare(0, tag.size(), tag) == 0; }))
+                    << "No decoded lines " << tag;
+        }
+        EXPECT_FALSE(lines[0].empty());
+        sort(lines[0].begin(), lines[0].end());
+        sort(lines[1].begin(), lines[1].end());
+        EXPECT_EQ(lines[0], lines[1]);
+}
+
+TEST(ScenarioCompare, counter_threads)
+{
+        // -----------------------------------------------------------------------------------------
+        // Counter-based draws: the same cases with 1 and with 4 threads.
+        // -----------------------------------------------------------------------------------------
+        auto config = get<0>(ScenarioData::Get("covid19_counter"));
+        config.put("run.num_threads", 1U);
+        const auto sim1 = RunScenario(config, "1");
+        config.put("run.num_threads", 4U);
+        const auto sim4 = RunScenario(config, "4");
+
+        const auto pop1 = sim1->GetPopulation();
+        const auto pop4 = sim4->GetPopulation();
+        EXPECT_GT(pop1->GetTotalInfected(), 0U);
+        EXPECT_EQ(pop1->GetTotalInfected(), pop4->GetTotalInfected());
+        EXPECT_EQ(GetHealthStatus(*pop1), GetHealthStatus(*pop4));
+}
+
+TEST(ScenarioCompare, checkpoint_restore)
+{
+        // -----------------------------------------------------------------------------------------
+        // Scenario with contact tracing active across the checkpoint day, with either generator.
+        // -----------------------------------------------------------------------------------------
+        for (const string rngType : {"Stream", "Counter"}) {
+                auto config = get<0>(ScenarioData::Get("covid19_tracing"));
+                config.put("run.rng_type", rngType);
+                config.put("run.num_days", 30U);
+                config.put("run.num_threads", 2U);
+                const auto straight = RunScenario(config, rngType + "_straight");
+
+                // ---------------------------------------------------------------------------------
+                // Checkpoint at day 12 (and finish), restore into a fresh simulator and finish.
+                // ---------------------------------------------------------------------------------
+                const auto checkpointFile = GetOutputPrefix(rngType) + ".bin";
+                auto       saveConfig     = config;
+                saveConfig.put("run.checkpoint_file", checkpointFile);
+                saveConfig.put("run.checkpoint_day", 12U);
+                const auto saved = RunScenario(saveConfig, rngType + "_saved");
+                auto restoreConfig = config;
+                restoreConfig.put("run.restore_file", checkpointFile);
+                restoreConfig.put("run.rng_seed", config.get<unsigned int>("run.rng_seed") + 1U); // restored too
+                const auto restored = RunScenario(restoreConfig, rngType + "_restored");
+
+                const auto pop = straight->GetPopulation();
+                EXPECT_GT(pop->GetTotalInfected(), 0U) << rngType;
+                for (const auto& sim : {saved, restored}) {
+                        EXPECT_EQ(pop->GetTotalInfected(), sim->GetPopulation()->GetTotalInfected()) << rngType;
+                        EXPECT_EQ(GetHealthStatus(*pop), GetHealthStatus(*sim->GetPopulation())) << rngType;
+                }
+        }
+}
+
+TEST(ScenarioCompare, branch_without_overrides)
+{
+        // -----------------------------------------------------------------------------------------
+        // A branch without overrides reproduces the run without branches.
+        // -----------------------------------------------------------------------------------------
+        auto config = get<0>(ScenarioData::Get("covid19_tracing"));
+        config.put("run.num_days", 30U);
+        config.put("run.num_threads", 2U);
+        const auto straight = RunScenario(config, "straight");
+
+        config.put("run.branch_day", 12U);
+        config.put_child("run.branches.branch", ptree());
+        const auto branch = RunScenario(config, "branches");
+
+        const auto pop = straight->GetPopulation();
+        EXPECT_GT(pop->GetTotalInfected(), 0U);
+        EXPECT_EQ(pop->GetTotalInfected(), branch->GetPopulation()->GetTotalInfected());
+        EXPECT_EQ(GetHealthStatus(*pop), GetHealthStatus(*branch->GetPopulation()));
+}
+
+TEST(ScenarioCompare, population_reset)
+{
+        // -----------------------------------------------------------------------------------------
+        // Two equal rows, one at a time: the second runs on the population of the first, reset.
+        // -----------------------------------------------------------------------------------------
+        auto config = get<0>(ScenarioData::Get("covid19_tracing"));
+        config.put("run.num_days", 30U);
+        config.put("run.batch_parallelism", "Simulation");
+        config.put("run.output_cases", true);
+        const auto prefix = RunDesign(config, "num_days\n30\n30\n", "rows");
+        const auto cases1 = ReadFile(FileSys::BuildPath(prefix, "exp0001/cases.csv"));
+        const auto cases2 = ReadFile(FileSys::BuildPath(prefix, "exp0002/cases.csv"));
+        EXPECT_FALSE(cases1.empty());
+        EXPECT_EQ(cases1, cases2);
+}
+
+TEST(ScenarioCompare, batch_parallelism)
+{
+        // -----------------------------------------------------------------------------------------
+        // Counter-based draws: the same outputs for rows run at the same time (with a thread each)
+        // and for rows run one at a time (with the 4 threads of the rows).
+        // -----------------------------------------------------------------------------------------
+        auto config = get<0>(ScenarioData::Get("covid19_counter"));
+        config.put("run.num_days", 30U);
+        config.put("run.num_threads", 4U);
+        config.put("run.output_cases", true);
+        string prefixes[2];
+        for (const string policy : {"Runs", "Simulation"}) {
+                config.put("run.batch_parallelism", policy);
+                prefixes[policy == "Simulation"] = RunDesign(config, "rng_seed\n1\n2\n", policy);
+        }
+        for (const string row : {"exp0001", "exp0002"}) {
+                const auto cases = ReadFile(FileSys::BuildPath(prefixes[0], row + "/cases.csv"));
+                EXPECT_FALSE(cases.empty()) << row;
+                EXPECT_EQ(cases, ReadFile(FileSys::BuildPath(prefixes[1], row + "/cases.csv"))) << row;
+        }
+}
+
+TEST(ScenarioCompare, sparse_index_cases)
+{
+        // -----------------------------------------------------------------------------------------
+        // Index cases with counter-based draws: the same secondary cases with 1 and with 4 threads.
+        // -----------------------------------------------------------------------------------------
+        auto config = get<0>(ScenarioData::Get("covid19_counter"));
+        config.put("run.track_index_case", true);
+        config.put("run.sparse_index_cases", true);
+        vector<string> lines[2];
+        for (const auto numThreads : {1U, 4U}) {
+                const auto prefix = GetOutputPrefix(to_string(numThreads));
+                config.put("run.num_threads", numThreads);
+                config.put("run.output_prefix", prefix + "/");
+                {
+                        SimController controller(config, "TestController");
+                        controller.Control();
+                }
+                ifstream file(FileSys::BuildPath(prefix, "index_cases.csv").string());
+                ReadLines(file, lines[numThreads > 1U]);
+        }
+        const auto numIndexCases = config.get<unsigned int>("run.num_infected_seeds");
+        ASSERT_EQ(lines[0].size(), numIndexCases + 1U);
+        EXPECT_EQ(lines[0], lines[1]);
+
+        // -----------------------------------------------------------------------------------------
+        // The mean number of secondary cases is that of the index cases of a full run, where they
+        // share some of their contacts (hence the margin: fewer secondary cases in the full run).
+        // -----------------------------------------------------------------------------------------
+        unsigned int numCases = 0U;
+        for (size_t i = 1U; i < lines[0].size(); i++) {
+                istringstream line(lines[0][i]);
+                string        id, age, secondaryCases;
+                getline(line, id, ',');
+                getline(line, age, ',');
+                getline(line, secondaryCases, ',');
+                numCases += stoul(secondaryCases);
+        }
+        config.put("run.sparse_index_cases", false);
+        const auto   sim        = RunScenario(config, "full");
+        const auto   numFull    = sim->GetPopulation()->GetTotalInfected() - numIndexCases;
+        const double meanSparse = static_cast<double>(numCases) / numIndexCases;
+        const double meanFull   = static_cast<double>(numFull) / numIndexCases;
+        EXPECT_GT(meanFull, 0.0);
+        EXPECT_NEAR(meanSparse, meanFull, 0.15 * meanFull);
+}
+
+} // namespace Tests
@@ -58,9 +58,11 @@ tuple<ptree, unsigned int, double> ScenarioData::Get(string tag)
 		{"r0_12", 23000U},        {"r0_16", 45000U},   {"covid19_base", 82500U}, {"covid19_all", 81000U},
 		{"covid19_daily", 91000U},{"covid19_distancing", 19000U}, {"covid19_age_15min",90000U},
 		{"covid19_householdclusters", 46000U}, {"covid19_tracing",41000U}, {"covid19_tracing_all",39000U},
+		{"covid19_tracing_delay0",41000U},
 		{"covid19_transm", 82500U},{"covid19_transm_gamma", 72300U},
 		{"covid19_suscept", 82500U},{"covid19_suscept_age", 82500U},{"covid19_suscept_adapt", 56650U},
-		{"covid19_fitting", 82500U},{"covid19_fitting_adapt", 41100U}};
+		{"covid19_fitting", 82500U},{"covid19_fitting_adapt", 41100U},
+		{"covid19_geometric", 82500U},{"covid19_counter", 82500U}};
 
 
 	// Set margins per scenario
@@ -70,10 +72,11 @@ tuple<ptree, unsigned int, double> ScenarioData::Get(string tag)
 		{"r0_12", 5.0e-02},       {"r0_16", 5.0e-02},   {"covid19_base", 1.0e-01},  {"covid19_all", 1.0e-01},
 		{"covid19_daily", 1.0e-01},{"covid19_distancing", 1.0e-01},{"covid19_age_15min",1.0e-1},
 		{"covid19_householdclusters", 1.5e-01}, // more stochastic effects observed
-		{"covid19_tracing",1.0e-01}, {"covid19_tracing_all",1.0e-01},
+		{"covid19_tracing",1.0e-01}, {"covid19_tracing_all",1.0e-01}, {"covid19_tracing_delay0",1.0e-01},
 		{"covid19_transm", 1.0e-01},{"covid19_transm_gamma", 1.0e-01},
 		{"covid19_suscept", 1.0e-01},{"covid19_suscept_age", 1.0e-01},{"covid19_suscept_adapt", 1.0e-01},
-		{"covid19_fitting", 1.0e-01},{"covid19_fitting_adapt", 1.0e-01}};
+		{"covid19_fitting", 1.0e-01},{"covid19_fitting_adapt", 1.0e-01},
+		{"covid19_geometric", 1.0e-01},{"covid19_counter", 1.0e-01}};
 
 	unsigned int target;
 	double       margin;
@@ -142,7 +145,7 @@ tuple<ptree, unsigned int, double> ScenarioData::Get(string tag)
 			pt.put("run.cnt_intensity_householdCluster", 4/7);
 	}
 	// set default tracing parameters
-	if (tag == "covid19_tracing" || tag == "covid19_tracing_all") {
+	if (tag == "covid19_tracing" || tag == "covid19_tracing_all" || tag == "covid19_tracing_delay0") {
 		    pt.put("run.event_log_level", "Transmissions");
 			pt.put("run.holidays_file", "calendar_belgium_2020_covid19_exit_schoolcategory_adjusted.csv");
 			pt.put("run.start_date", "2020-06-01");
@@ -153,6 +156,10 @@ tuple<ptree, unsigned int, double> ScenarioData::Get(string tag)
 			pt.put("run.case_finding_capacity", 1000U);
 
 	}
+	// isolate traced contacts on the day of tracing (as of the contacts of the next day)
+	if (tag == "covid19_tracing_delay0") {
+			pt.put("run.delay_contact_tracing", 0U);
+	}
 	// change log parameter to use the optimized version
 	if (tag == "covid19_tracing_all") {
 			pt.put("run.event_log_level", "ContactTracing");
@@ -211,6 +218,13 @@ tuple<ptree, unsigned int, double> ScenarioData::Get(string tag)
 	}
 
 
+	if (tag == "covid19_geometric") {
+		pt.put("run.transmission_sampling", "Geometric");
+	}
+
+	if (tag == "covid19_counter") {
+		pt.put("run.rng_type", "Counter");
+	}
 
 	return make_tuple(pt, target, margin);
 }
@@ -93,6 +93,17 @@ void RunTest(const string& testTag, tuple<ptree, unsigned int, double> d, unsign
         EXPECT_NEAR(res, target, target * margin)
             << "Failure at scenario: " << testTag << " with number of threads: " << numThreads << endl;
 
+        // -----------------------------------------------------------------------------------------
+        // Check the incrementally kept counts against a scan of the population.
+        // -----------------------------------------------------------------------------------------
+        using HS = HealthStatus;
+        EXPECT_EQ(res, pop->ScanHealthStatus({HS::Exposed, HS::Infectious, HS::Symptomatic,
+                                              HS::InfectiousAndSymptomatic, HS::Recovered}));
+        EXPECT_EQ(pop->CountInfectedCases(), pop->ScanHealthStatus({HS::Exposed, HS::Infectious, HS::Symptomatic,
+                                                                    HS::InfectiousAndSymptomatic}));
+        EXPECT_EQ(pop->CountExposedCases(), pop->ScanHealthStatus({HS::Exposed}));
+        EXPECT_EQ(pop->CountInfectiousCases(), pop->ScanHealthStatus({HS::Infectious, HS::InfectiousAndSymptomatic}));
+        EXPECT_EQ(pop->CountSymptomaticCases(), pop->ScanHealthStatus({HS::Symptomatic, HS::InfectiousAndSymptomatic}));
 
 }
 
@@ -120,10 +131,10 @@ const char* tags_measles[] = {"measles_16", "measles_26"};
 const char* tags_r0[] = {"r0_0", "r0_4", "r0_8", "r0_12", "r0_16"};
 
 const char* tags_covid19[] = {"covid19_base", "covid19_all", "covid19_daily", "covid19_distancing",
-		"covid19_age_15min", "covid19_householdclusters", "covid19_tracing","covid19_tracing_all",
+		"covid19_age_15min", "covid19_householdclusters", "covid19_tracing","covid19_tracing_all","covid19_tracing_delay0",
 		"covid19_transm","covid19_transm_gamma",
 		"covid19_suscept","covid19_suscept_age","covid19_suscept_adapt",
-		"covid19_fitting","covid19_fitting_adapt"};
+		"covid19_fitting","covid19_fitting_adapt","covid19_geometric","covid19_counter"};
 
 } // namespace
 